@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,14 +10,41 @@ struct AppConfig {
     std::string windowTitle{"Terra Clone"};
     int windowWidth{1280};
     int windowHeight{720};
-    int targetFps{60};
+    int targetFps{60}; // render cap; 0 leaves pacing to vsync alone
+    int simulationHz{60};
+    int maxCatchUpSteps{5};
+    bool vsync{true};
     int worldWidth{4096};
     int worldHeight{768};
+    float autosaveIntervalSeconds{120.0F};
+    bool deltaWorldSaves{false};
+    bool compressedWorldSaves{false};
+    int editLogFlushMs{250};
+    // One simulation step per frame regardless of wall-clock time, with every random stream derived
+    // from simulationSeed, so two runs fed the same input produce the same per-tick state hashes.
+    bool deterministic{false};
+    std::uint64_t simulationSeed{0x5EEDULL};
+    int stateHashLogTicks{600}; // deterministic mode logs the state hash this often; 0 disables
+    std::string recordInputPath{}; // append every polled input frame here
+    std::string replayInputPath{}; // read input from a recording instead of the keyboard and mouse
+    bool persistSaves{true};       // false keeps the session from checkpointing or logging edits
+    bool headless{false};          // null renderer and input; always on in builds with TERRARIA_HEADLESS
+    bool autoStartSession{false};  // skip the menus and play a throwaway world generated from the seed
+    std::uint64_t maxTicks{0};     // stop after this many simulation steps; 0 runs until quit
+    int traceFrames{0};            // capture a Chrome trace of the first frames at startup; 0 waits for /trace
+    std::string tracePath{"trace.json"};
+    float perfWindowSeconds{10.0F};  // span of the frame-time percentiles on the perf panel
+    float hitchThresholdMs{0.0F};    // frames whose work takes longer are logged; 0 (the default) disables
+    std::string hitchLogPath{"hitches.log"};
+    int maxZombies{12}; // night spawning stops at these counts
+    int maxFlyers{8};
+    int maxWorms{6};
 };
 
 class Application {
 public:
     Application();
+    explicit Application(AppConfig config);
     ~Application();
 
     void run();
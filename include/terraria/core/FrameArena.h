@@ -0,0 +1,41 @@
+#pragma once
+
+#include "terraria/core/MemoryTags.h"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace terraria::core {
+
+// Bump allocator for data that lives no longer than one frame, usable by any std::pmr container.
+// Deallocation is a no-op; reset() at the end of the frame reclaims everything at once, so nothing
+// allocated from it may be touched afterwards. A frame that outgrows the block spills into the
+// general heap and the block is enlarged at the next reset, so steady-state frames stay in place.
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    // The block is charged to tag; frame data is mostly HUD and overlay scratch.
+    explicit FrameArena(std::size_t capacity = 256 * 1024, MemoryTag tag = MemoryTag::Hud);
+    ~FrameArena() override;
+
+    void reset();
+
+    std::size_t used() const { return offset_ + spilled_; }
+    std::size_t capacity() const { return capacity_; }
+    std::size_t peak() const { return peak_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    MemoryTag tag_;
+    std::unique_ptr<std::byte[]> block_;
+    std::size_t capacity_{0};
+    std::size_t offset_{0};
+    std::size_t spilled_{0};
+    std::size_t peak_{0};
+    std::pmr::monotonic_buffer_resource spill_{std::pmr::new_delete_resource()};
+};
+
+} // namespace terraria::core
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+
+namespace terraria::core {
+
+// Holds frames to a target rate: sleeps until shortly before each deadline, then spins the rest so
+// wake-up jitter from the OS scheduler does not show up as uneven frames. With vsync the present
+// call already blocks, so frames that arrive close to the deadline are not held a second time.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    FramePacer(int targetFps, bool vsync);
+
+    // Seconds since the previous call; the first call returns one target period.
+    float beginFrame();
+    void waitForNextFrame();
+
+private:
+    Clock::duration period_{};
+    bool vsync_{false};
+    Clock::time_point lastFrame_{};
+    Clock::time_point deadline_{};
+    bool started_{false};
+};
+
+} // namespace terraria::core
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace terraria::core {
+
+struct TimingSummary {
+    float p50{0.0F};
+    float p95{0.0F};
+    float p99{0.0F};
+    float max{0.0F};
+};
+
+// Millisecond timings over a sliding wall-clock window. Samples are counted into logarithmic buckets
+// (about 12% wide, 0.1 ms up to 145 ms, the last one open-ended) so percentiles cost one pass over the
+// buckets rather than a sort; they report the bucket's upper edge, capped by the exact maximum. When
+// more than maxSamples fall inside the window the oldest leave early.
+class RollingHistogram {
+public:
+    static constexpr std::size_t kBuckets = 64;
+
+    explicit RollingHistogram(double windowSeconds = 10.0, std::size_t maxSamples = 4096);
+
+    void add(double nowSeconds, float ms);
+    TimingSummary summary() const;
+
+    const std::array<std::uint32_t, kBuckets>& buckets() const { return counts_; }
+    std::size_t sampleCount() const { return size_; }
+
+    static std::size_t bucketFor(float ms);
+    static float bucketUpperMs(std::size_t bucket);
+
+private:
+    struct Sample {
+        double time{0.0};
+        float ms{0.0F};
+        std::uint8_t bucket{0};
+    };
+
+    void dropOldest();
+
+    double window_;
+    std::vector<Sample> ring_;
+    std::size_t head_{0};
+    std::size_t size_{0};
+    std::array<std::uint32_t, kBuckets> counts_{};
+};
+
+// Adds the wall time of its scope, in milliseconds, to total.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(float& total) : total_{total}, start_{std::chrono::steady_clock::now()} {}
+    ~ScopedTimer() {
+        total_ += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    float& total_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace terraria::core
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace terraria::core {
+
+// Number of global operator new calls since startup, from every thread. Sampled around a frame it
+// shows how much general-purpose heap traffic the frame generates.
+std::uint64_t HeapAllocationCount();
+
+} // namespace terraria::core
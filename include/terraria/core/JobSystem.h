@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace terraria::core {
+
+using JobFunction = std::function<void()>;
+
+// Counts outstanding jobs of one group. Jobs may be queued to start only once another counter is done.
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    struct Deferred {
+        JobFunction fn;
+        JobCounter* counter;
+        const char* name;
+    };
+
+    std::atomic<int> pending_{0};
+    mutable std::mutex mutex_{};
+    mutable std::vector<Deferred> deferred_{};
+};
+
+// Called around every job on the thread that runs it; both must be set together.
+struct JobTraceHooks {
+    void (*begin)(const char* name){nullptr};
+    void (*end)(const char* name){nullptr};
+};
+
+// Fixed pool of workers with one deque each: a worker pops its own newest job and steals the oldest
+// from the others when it runs dry. Threads outside the pool share one submission deque. With a
+// thread count of 1 there are no workers and every job runs inline as soon as it may start.
+class JobSystem {
+public:
+    explicit JobSystem(int threadCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Process-wide pool sized to the hardware.
+    static JobSystem& Shared();
+
+    // Worker threads plus the calling thread.
+    int threadCount() const { return static_cast<int>(queues_.size()); }
+
+    void run(JobFunction fn, JobCounter& counter, const char* name = "job");
+    // As run, but the job is not queued before dependency is done.
+    void runAfter(const JobCounter& dependency, JobFunction fn, JobCounter& counter, const char* name = "job");
+    // Runs counter's own queued jobs on the calling thread until it is done. Jobs of other groups are
+    // left to the workers, so a frame waiting on its fog pass never picks up a background save's chunks.
+    void wait(const JobCounter& counter);
+
+    // Calls fn(begin, end) over [0, count) in chunks of at least grain indices and returns when all are done.
+    // fn is borrowed rather than wrapped in a JobFunction, so splitting the range does not allocate.
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t grain, Fn&& fn, const char* name = "parallelFor") {
+        using Callable = std::remove_reference_t<Fn>;
+        const RangeTask task{const_cast<void*>(static_cast<const void*>(std::addressof(fn))),
+                             [](void* context, std::size_t begin, std::size_t end) {
+                                 (*static_cast<Callable*>(context))(begin, end);
+                             }};
+        parallelForRange(count, grain, task, name);
+    }
+
+    void setTraceHooks(JobTraceHooks hooks) { hooks_ = hooks; }
+
+private:
+    struct RangeTask {
+        void* context{nullptr};
+        void (*invoke)(void* context, std::size_t begin, std::size_t end){nullptr};
+    };
+
+    // Either an owned function or one chunk of a borrowed range task.
+    struct Job {
+        JobFunction fn{};
+        RangeTask range{};
+        std::size_t begin{0};
+        std::size_t end{0};
+        JobCounter* counter{nullptr};
+        const char* name{nullptr};
+    };
+
+    // Ring buffer rather than std::deque so a steady stream of jobs reuses the same storage.
+    struct Queue {
+        std::mutex mutex{};
+        std::vector<Job> ring{};
+        std::size_t head{0};
+        std::size_t size{0};
+
+        void pushBack(Job job);
+        void popBack(Job& job);
+        void popFront(Job& job);
+        // Removes the newest job of counter, if any; the queue's order is otherwise kept.
+        bool take(const JobCounter& counter, Job& job);
+    };
+
+    void parallelForRange(std::size_t count, std::size_t grain, RangeTask task, const char* name);
+    void push(Job job);
+    bool tryRunOne();
+    bool tryRunOneOf(const JobCounter& counter);
+    bool pop(std::size_t queue, Job& job);
+    bool steal(std::size_t thief, Job& job);
+    void execute(Job& job);
+    void finish(JobCounter& counter);
+    void workerLoop(std::size_t queue);
+
+    std::vector<std::unique_ptr<Queue>> queues_{};
+    std::vector<std::thread> workers_{};
+    std::atomic<int> queued_{0};
+    std::mutex sleepMutex_{};
+    std::condition_variable wake_{};
+    bool stopping_{false};
+    JobTraceHooks hooks_{};
+};
+
+} // namespace terraria::core
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace terraria::core {
+
+// Subsystems whose heap use is accounted separately. Only containers that opt in through
+// TrackedAllocator (or explicit Track* calls) are counted, so the tags need not add up to the process.
+enum class MemoryTag : std::uint8_t {
+    World,
+    ExploredMaps,
+    Enemies,
+    SaveBuffers,
+    Textures,
+    Hud,
+    Count
+};
+
+constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+struct MemoryTagUsage {
+    std::size_t live{0};
+    std::size_t peak{0};
+};
+
+const char* MemoryTagName(MemoryTag tag);
+MemoryTagUsage MemoryUsage(MemoryTag tag);
+
+namespace detail {
+struct MemoryTagCounters {
+    std::atomic<std::size_t> live{0};
+    std::atomic<std::size_t> peak{0};
+};
+extern std::array<MemoryTagCounters, kMemoryTagCount> memoryTagCounters;
+} // namespace detail
+
+inline void TrackAllocation(MemoryTag tag, std::size_t bytes) {
+    auto& counters = detail::memoryTagCounters[static_cast<std::size_t>(tag)];
+    const std::size_t live = counters.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = counters.peak.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+inline void TrackDeallocation(MemoryTag tag, std::size_t bytes) {
+    detail::memoryTagCounters[static_cast<std::size_t>(tag)].live.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+// std::allocator that charges every block to Tag: two relaxed atomics per allocation, no per-block header.
+template <typename T, MemoryTag Tag>
+class TrackedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackedAllocator<U, Tag>;
+    };
+
+    TrackedAllocator() noexcept = default;
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        T* block = std::allocator<T>{}.allocate(count);
+        TrackAllocation(Tag, count * sizeof(T));
+        return block;
+    }
+
+    void deallocate(T* block, std::size_t count) noexcept {
+        TrackDeallocation(Tag, count * sizeof(T));
+        std::allocator<T>{}.deallocate(block, count);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Tag>&) const noexcept {
+        return true;
+    }
+};
+
+template <typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+} // namespace terraria::core
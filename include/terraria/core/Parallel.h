@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace terraria::core {
+
+int DefaultThreadCount();
+
+// Runs fn(i) for every i in [0, count) on up to threadCount threads of the shared JobSystem, the calling
+// thread included.
+void ParallelFor(std::size_t count, int threadCount, const std::function<void(std::size_t)>& fn);
+
+} // namespace terraria::core
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace terraria::core {
+
+inline std::uint64_t SplitMix64(std::uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+// Independent seed for one named random stream, so draws in one subsystem never shift another's.
+inline std::uint32_t StreamSeed(std::uint64_t seed, std::uint64_t stream) {
+    return static_cast<std::uint32_t>(SplitMix64(seed ^ SplitMix64(stream)));
+}
+
+} // namespace terraria::core
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+
+// Builds with TERRARIA_TRACING=0 compile every TERRARIA_TRACE_* macro away.
+#ifndef TERRARIA_TRACING
+#define TERRARIA_TRACING 1
+#endif
+
+namespace terraria::core {
+
+constexpr bool kTracingCompiledIn = TERRARIA_TRACING != 0;
+
+namespace detail {
+extern std::atomic<bool> traceCapturing;
+} // namespace detail
+
+// Outside a capture every zone, counter and marker costs this one relaxed load.
+inline bool TraceCapturing() {
+    return detail::traceCapturing.load(std::memory_order_relaxed);
+}
+
+// Records the next frames frames, then writes them to path in the Chrome trace event format that
+// chrome://tracing and Perfetto open. Returns false if a capture is already running.
+bool StartTraceCapture(int frames, std::string path);
+// Called once at the end of every frame. Returns true on the frame that completes a capture, with the
+// file it went to in outPath and whether writing it succeeded in outWritten.
+bool EndTraceFrame(std::string& outPath, bool& outWritten);
+
+// Each thread records into its own ring buffer, so a long capture keeps its newest events.
+// Names must outlive the capture; string literals are the intended use.
+bool TraceBegin(const char* name);
+void TraceEnd(const char* name);
+void TraceCounter(const char* name, double value);
+void TraceMarker(const char* name);
+void SetTraceThreadName(const char* name);
+
+class TraceZone {
+public:
+    explicit TraceZone(const char* name) : name_{TraceCapturing() && TraceBegin(name) ? name : nullptr} {}
+    ~TraceZone() {
+        if (name_ != nullptr) {
+            TraceEnd(name_);
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name_;
+};
+
+} // namespace terraria::core
+
+#if TERRARIA_TRACING
+#define TERRARIA_TRACE_JOIN_(a, b) a##b
+#define TERRARIA_TRACE_JOIN(a, b) TERRARIA_TRACE_JOIN_(a, b)
+#define TERRARIA_TRACE_ZONE(name) const ::terraria::core::TraceZone TERRARIA_TRACE_JOIN(traceZone_, __LINE__){name}
+#define TERRARIA_TRACE_COUNTER(name, value)                                                 \
+    do {                                                                                    \
+        if (::terraria::core::TraceCapturing()) {                                           \
+            ::terraria::core::TraceCounter(name, static_cast<double>(value));               \
+        }                                                                                   \
+    } while (false)
+#define TERRARIA_TRACE_MARKER(name)                                                         \
+    do {                                                                                    \
+        if (::terraria::core::TraceCapturing()) {                                           \
+            ::terraria::core::TraceMarker(name);                                            \
+        }                                                                                   \
+    } while (false)
+#else
+#define TERRARIA_TRACE_ZONE(name) static_cast<void>(0)
+#define TERRARIA_TRACE_COUNTER(name, value) static_cast<void>(0)
+#define TERRARIA_TRACE_MARKER(name) static_cast<void>(0)
+#endif
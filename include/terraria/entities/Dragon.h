@@ -11,7 +11,9 @@ inline constexpr float kDragonHeight = 2.2F;
 
 struct Dragon {
     Vec2 position{};
+    Vec2 previousPosition{};
     Vec2 velocity{};
+    int body{-1}; // index into the current step's game::BodyStore
     int maxHealth{420};
     int health{420};
     float attackCooldown{0.0F};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "terraria/core/MemoryTags.h"
 #include "terraria/entities/Tools.h"
 #include "terraria/entities/Vec2.h"
 #include "terraria/world/Tile.h"
@@ -59,6 +60,8 @@ public:
     bool addAccessory(AccessoryId accessoryId);
     void setPosition(Vec2 pos) { position_ = pos; }
     Vec2 position() const { return position_; }
+    void storePreviousPosition() { previousPosition_ = position_; }
+    Vec2 previousPosition() const { return previousPosition_; }
 
     void setVelocity(Vec2 velocity) { velocity_ = velocity; }
     Vec2 velocity() const { return velocity_; }
@@ -118,17 +121,50 @@ public:
     void revealRect(const std::string& worldId, int startX, int startY, int width, int height);
     void clearExplored(const std::string& worldId);
     void clearExploredMaps() { exploredMaps_.clear(); }
+    // Explored alpha per world tile, split into square map tiles. A map tile whose cells all share
+    // one value (fully hidden or fully revealed) stores just that value; only tiles on the fog
+    // frontier keep a per-cell byte array.
     struct MapExploration {
+        static constexpr int kTileSize = 32;
+        static constexpr int kTileCells = kTileSize * kTileSize;
+
         int width{0};
         int height{0};
-        std::vector<std::uint8_t> data{};
+        int tilesX{0};
+        int tilesY{0};
+        using Bytes = core::TrackedVector<std::uint8_t, core::MemoryTag::ExploredMaps>;
+
+        Bytes uniform{};
+        core::TrackedVector<Bytes, core::MemoryTag::ExploredMaps> detail{};
+        core::TrackedVector<std::uint16_t, core::MemoryTag::ExploredMaps> fullCount{};
+        std::uint32_t revision{0};
+
+        bool empty() const { return uniform.empty(); }
+        void reset(int newWidth, int newHeight);
+        void fill(std::uint8_t value);
+        std::uint8_t value(int x, int y) const;
+        bool raise(int x, int y, std::uint8_t value);
+        bool raiseRect(int minX, int minY, int maxX, int maxY, std::uint8_t value);
+        std::size_t tileIndex(int x, int y) const {
+            return static_cast<std::size_t>((y / kTileSize) * tilesX + x / kTileSize);
+        }
+        std::size_t cellIndex(int x, int y) const {
+            return static_cast<std::size_t>((y % kTileSize) * kTileSize + x % kTileSize);
+        }
+        int cellsInTile(std::size_t tile) const {
+            const int tx = static_cast<int>(tile) % tilesX;
+            const int ty = static_cast<int>(tile) / tilesX;
+            return std::min(kTileSize, width - tx * kTileSize) * std::min(kTileSize, height - ty * kTileSize);
+        }
     };
     const std::unordered_map<std::string, MapExploration>& exploredMaps() const { return exploredMaps_; }
+    const MapExploration* exploredMap(const std::string& worldId) const;
     void setExploredMap(const std::string& worldId, MapExploration map);
 
 private:
     void recalcEquipmentStats();
     Vec2 position_{};
+    Vec2 previousPosition_{};
     Vec2 velocity_{};
     bool onGround_{false};
     int health_{kPlayerMaxHealth};
@@ -338,12 +374,11 @@ inline void terraria::entities::Player::ensureExploredSize(const std::string& wo
         return;
     }
     auto& entry = exploredMaps_[worldId];
-    if (entry.width == width && entry.height == height && !entry.data.empty()) {
+    if (entry.width == width && entry.height == height && !entry.empty()) {
         return;
     }
-    entry.width = width;
-    entry.height = height;
-    entry.data.assign(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0);
+    entry.reset(width, height);
+    ++entry.revision;
 }
 
 inline bool terraria::entities::Player::isExplored(const std::string& worldId, int x, int y) const {
@@ -358,11 +393,10 @@ inline bool terraria::entities::Player::isExplored(const std::string& worldId, i
     if (x < 0 || y < 0 || x >= entry.width || y >= entry.height) {
         return false;
     }
-    if (entry.data.empty()) {
+    if (entry.empty()) {
         return false;
     }
-    const std::size_t idx = static_cast<std::size_t>(y * entry.width + x);
-    return entry.data[idx] != 0;
+    return entry.value(x, y) != 0;
 }
 
 inline void terraria::entities::Player::setExplored(const std::string& worldId, int x, int y, bool explored) {
@@ -381,10 +415,10 @@ inline std::uint8_t terraria::entities::Player::exploredValue(const std::string&
     if (x < 0 || y < 0 || x >= entry.width || y >= entry.height) {
         return 0;
     }
-    if (entry.data.empty()) {
+    if (entry.empty()) {
         return 0;
     }
-    return entry.data[static_cast<std::size_t>(y * entry.width + x)];
+    return entry.value(x, y);
 }
 
 inline void terraria::entities::Player::setExploredValue(const std::string& worldId,
@@ -402,11 +436,12 @@ inline void terraria::entities::Player::setExploredValue(const std::string& worl
     if (x < 0 || y < 0 || x >= entry.width || y >= entry.height) {
         return;
     }
-    if (entry.data.empty()) {
+    if (entry.empty()) {
         return;
     }
-    const std::size_t idx = static_cast<std::size_t>(y * entry.width + x);
-    entry.data[idx] = std::max(entry.data[idx], value);
+    if (entry.raise(x, y, value)) {
+        ++entry.revision;
+    }
 }
 
 inline void terraria::entities::Player::revealRect(const std::string& worldId,
@@ -422,7 +457,7 @@ inline void terraria::entities::Player::revealRect(const std::string& worldId,
         return;
     }
     auto& entry = it->second;
-    if (entry.data.empty()) {
+    if (entry.empty()) {
         return;
     }
     const int minX = std::max(startX, 0);
@@ -432,12 +467,8 @@ inline void terraria::entities::Player::revealRect(const std::string& worldId,
     if (minX > maxX || minY > maxY) {
         return;
     }
-    for (int y = minY; y <= maxY; ++y) {
-        const std::size_t row = static_cast<std::size_t>(y * entry.width);
-        for (int x = minX; x <= maxX; ++x) {
-            const std::size_t idx = row + static_cast<std::size_t>(x);
-            entry.data[idx] = std::max(entry.data[idx], static_cast<std::uint8_t>(255));
-        }
+    if (entry.raiseRect(minX, minY, maxX, maxY, 255)) {
+        ++entry.revision;
     }
 }
 
@@ -449,7 +480,8 @@ inline void terraria::entities::Player::clearExplored(const std::string& worldId
     if (it == exploredMaps_.end()) {
         return;
     }
-    std::fill(it->second.data.begin(), it->second.data.end(), 0);
+    it->second.fill(0);
+    ++it->second.revision;
 }
 
 inline void terraria::entities::Player::setExploredMap(const std::string& worldId, MapExploration map) {
@@ -458,3 +490,88 @@ inline void terraria::entities::Player::setExploredMap(const std::string& worldI
     }
     exploredMaps_[worldId] = std::move(map);
 }
+
+inline const terraria::entities::Player::MapExploration* terraria::entities::Player::exploredMap(
+    const std::string& worldId) const {
+    auto it = exploredMaps_.find(worldId);
+    if (it == exploredMaps_.end() || it->second.empty()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+inline void terraria::entities::Player::MapExploration::reset(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    tilesX = (newWidth + kTileSize - 1) / kTileSize;
+    tilesY = (newHeight + kTileSize - 1) / kTileSize;
+    const std::size_t tileCount = static_cast<std::size_t>(tilesX) * static_cast<std::size_t>(tilesY);
+    uniform.assign(tileCount, 0);
+    detail.assign(tileCount, {});
+    fullCount.assign(tileCount, 0);
+}
+
+inline void terraria::entities::Player::MapExploration::fill(std::uint8_t value) {
+    std::fill(uniform.begin(), uniform.end(), value);
+    for (auto& cells : detail) {
+        cells.clear();
+        cells.shrink_to_fit();
+    }
+    std::fill(fullCount.begin(), fullCount.end(), 0);
+}
+
+inline std::uint8_t terraria::entities::Player::MapExploration::value(int x, int y) const {
+    const std::size_t tile = tileIndex(x, y);
+    const auto& cells = detail[tile];
+    return cells.empty() ? uniform[tile] : cells[cellIndex(x, y)];
+}
+
+inline bool terraria::entities::Player::MapExploration::raise(int x, int y, std::uint8_t value) {
+    const std::size_t tile = tileIndex(x, y);
+    auto& cells = detail[tile];
+    if (cells.empty()) {
+        if (value <= uniform[tile]) {
+            return false;
+        }
+        cells.assign(static_cast<std::size_t>(kTileCells), uniform[tile]);
+        fullCount[tile] = 0;
+    }
+    std::uint8_t& cell = cells[cellIndex(x, y)];
+    if (value <= cell) {
+        return false;
+    }
+    cell = value;
+    if (value == 255 && ++fullCount[tile] == cellsInTile(tile)) {
+        uniform[tile] = 255;
+        cells.clear();
+        cells.shrink_to_fit();
+    }
+    return true;
+}
+
+inline bool terraria::entities::Player::MapExploration::raiseRect(int minX, int minY, int maxX, int maxY, std::uint8_t value) {
+    bool changed = false;
+    for (int ty = minY / kTileSize; ty <= maxY / kTileSize; ++ty) {
+        for (int tx = minX / kTileSize; tx <= maxX / kTileSize; ++tx) {
+            const int tileMinX = tx * kTileSize;
+            const int tileMinY = ty * kTileSize;
+            const int tileMaxX = std::min(tileMinX + kTileSize, width) - 1;
+            const int tileMaxY = std::min(tileMinY + kTileSize, height) - 1;
+            const std::size_t tile = static_cast<std::size_t>(ty * tilesX + tx);
+            const bool covers = minX <= tileMinX && minY <= tileMinY && maxX >= tileMaxX && maxY >= tileMaxY;
+            if (covers && value == 255) {
+                changed = changed || uniform[tile] != 255 || !detail[tile].empty();
+                uniform[tile] = 255;
+                detail[tile].clear();
+                detail[tile].shrink_to_fit();
+                continue;
+            }
+            for (int y = std::max(minY, tileMinY); y <= std::min(maxY, tileMaxY); ++y) {
+                for (int x = std::max(minX, tileMinX); x <= std::min(maxX, tileMaxX); ++x) {
+                    changed = raise(x, y, value) || changed;
+                }
+            }
+        }
+    }
+    return changed;
+}
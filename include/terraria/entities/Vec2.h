@@ -7,4 +7,15 @@ struct Vec2 {
     float y{0.0F};
 };
 
+// Render-time blend between the last two simulation states. Moves longer than snapDistance
+// (spawns, respawns, teleports) are not smeared across the frame.
+inline Vec2 Interpolate(const Vec2& previous, const Vec2& current, float alpha, float snapDistance = 4.0F) {
+    const float dx = current.x - previous.x;
+    const float dy = current.y - previous.y;
+    if (dx * dx + dy * dy > snapDistance * snapDistance) {
+        return current;
+    }
+    return Vec2{previous.x + dx * alpha, previous.y + dy * alpha};
+}
+
 } // namespace terraria::entities
@@ -1,26 +1,18 @@
 #pragma once
 
-#include "terraria/entities/Vec2.h"
-
-#include <algorithm>
-
 namespace terraria::entities {
 
 inline constexpr float kZombieHalfWidth = 0.35F;
 inline constexpr float kZombieHeight = 1.6F;
+inline constexpr int kZombieMaxHealth = 100;
 
+// Per-zombie AI state. Position, velocity, health, body and id live in game::EnemyPool's hot arrays.
 struct Zombie {
-    Vec2 position{};
-    Vec2 velocity{};
     bool onGround{false};
-    int maxHealth{100};
-    int health{100};
     float attackCooldown{0.0F};
     float jumpCooldown{0.0F};
-    int id{0};
     float stuckTimer{0.0F};
     float lastX{0.0F};
-    float pathTimer{0.0F};
     int desiredDir{0};
     float lungeCooldown{0.0F};
     float lungeTimer{0.0F};
@@ -28,9 +20,6 @@ struct Zombie {
     float knockbackVelocity{0.0F};
     bool droppedLoot{false};
     float offscreenTimer{0.0F};
-
-    bool alive() const { return health > 0; }
-    void takeDamage(int amount) { health = std::max(0, health - amount); }
 };
 
 } // namespace terraria::entities
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "terraria/game/SaveManager.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace terraria::game {
+
+// Serializes and writes snapshots on a worker thread so saving never blocks a frame.
+// Only the newest pending snapshot is kept; older unsaved ones are superseded.
+class AutosaveService {
+public:
+    AutosaveService(const SaveManager& saveManager, float intervalSeconds);
+    ~AutosaveService();
+
+    AutosaveService(const AutosaveService&) = delete;
+    AutosaveService& operator=(const AutosaveService&) = delete;
+
+    void submit(WorldSnapshot world, CharacterSnapshot character, std::uint64_t tag = 0);
+    bool tick(float dt);
+    void resetTimer();
+    bool saving() const;
+    // savedTag is the tag of the newest snapshot written successfully so far (0 if none).
+    bool pollCompleted(bool& ok, std::uint64_t& savedTag);
+    void waitIdle();
+    void shutdown();
+
+private:
+    struct Job {
+        WorldSnapshot world{};
+        CharacterSnapshot character{};
+        std::uint64_t tag{0};
+    };
+
+    void workerLoop();
+
+    const SaveManager& saveManager_;
+    float interval_{0.0F};
+    float timer_{0.0F};
+
+    std::mutex mutex_{};
+    std::condition_variable wake_{};
+    std::condition_variable idle_{};
+    std::optional<Job> pending_{};
+    bool busy_{false};
+    bool stopping_{false};
+    int completed_{0};
+    bool lastOk_{true};
+    std::uint64_t savedTag_{0};
+    std::atomic<bool> saving_{false};
+    std::thread worker_{};
+};
+
+} // namespace terraria::game
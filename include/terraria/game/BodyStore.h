@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "terraria/entities/Vec2.h"
+
+namespace terraria::game {
+
+inline constexpr int kNoBody = -1;
+
+inline constexpr std::uint8_t kBodyCollides = 1U << 0; // box resolved against solid tiles
+inline constexpr std::uint8_t kBodyPoint = 1U << 1;    // zero-sized; stops on the first solid tile in its path
+inline constexpr std::uint8_t kBodyOnGround = 1U << 2;
+inline constexpr std::uint8_t kBodyHitWall = 1U << 3; // set by PhysicsSystem::step when a point body stops
+
+struct BodyBounds {
+    float minX{-std::numeric_limits<float>::infinity()};
+    float minY{-std::numeric_limits<float>::infinity()};
+    float maxX{std::numeric_limits<float>::infinity()};
+    float maxY{std::numeric_limits<float>::infinity()};
+};
+
+// Dynamic bodies in structure-of-arrays layout, rebuilt every simulation step: systems add their
+// bodies, PhysicsSystem::step moves them all at once, then each system reads its results back by id.
+struct BodyStore {
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> halfWidth;
+    std::vector<float> height;
+    std::vector<float> gravity;
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+    std::vector<std::uint8_t> flags;
+
+    std::size_t size() const { return posX.size(); }
+
+    void clear() {
+        posX.clear();
+        posY.clear();
+        velX.clear();
+        velY.clear();
+        halfWidth.clear();
+        height.clear();
+        gravity.clear();
+        minX.clear();
+        minY.clear();
+        maxX.clear();
+        maxY.clear();
+        flags.clear();
+    }
+
+    int add(const entities::Vec2& position,
+            const entities::Vec2& velocity,
+            float bodyHalfWidth,
+            float bodyHeight,
+            float bodyGravity,
+            std::uint8_t bodyFlags,
+            const BodyBounds& bounds = {}) {
+        const int id = static_cast<int>(size());
+        posX.push_back(position.x);
+        posY.push_back(position.y);
+        velX.push_back(velocity.x);
+        velY.push_back(velocity.y);
+        halfWidth.push_back(bodyHalfWidth);
+        height.push_back(bodyHeight);
+        gravity.push_back(bodyGravity);
+        minX.push_back(bounds.minX);
+        minY.push_back(bounds.minY);
+        maxX.push_back(bounds.maxX);
+        maxY.push_back(bounds.maxY);
+        flags.push_back(bodyFlags);
+        return id;
+    }
+
+    entities::Vec2 position(int id) const {
+        const auto at = static_cast<std::size_t>(id);
+        return {posX[at], posY[at]};
+    }
+
+    entities::Vec2 velocity(int id) const {
+        const auto at = static_cast<std::size_t>(id);
+        return {velX[at], velY[at]};
+    }
+
+    bool has(int id, std::uint8_t flag) const { return (flags[static_cast<std::size_t>(id)] & flag) != 0; }
+};
+
+} // namespace terraria::game
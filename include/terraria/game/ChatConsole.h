@@ -27,7 +27,7 @@ private:
     bool open_{false};
     std::string input_{};
     std::size_t cursor_{0};
-    std::vector<rendering::ChatLineHud> log_{};
+    rendering::HudList<rendering::ChatLineHud> log_{};
 };
 
 } // namespace terraria::game
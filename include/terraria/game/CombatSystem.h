@@ -1,12 +1,12 @@
 #pragma once
 
 #include "terraria/entities/Dragon.h"
-#include "terraria/entities/FlyingEnemy.h"
-#include "terraria/entities/Worm.h"
 #include "terraria/entities/Player.h"
-#include "terraria/entities/Zombie.h"
 #include "terraria/game/DamageNumberSystem.h"
+#include "terraria/game/EnemyPool.h"
 #include "terraria/game/PhysicsSystem.h"
+#include "terraria/game/SpatialHash.h"
+#include "terraria/game/StateHash.h"
 #include "terraria/rendering/HudState.h"
 #include "terraria/world/World.h"
 
@@ -22,13 +22,15 @@ public:
                  entities::Player& player,
                  PhysicsSystem& physics,
                  DamageNumberSystem& damageNumbers,
-                 std::vector<entities::Zombie>& zombies,
-                 std::vector<entities::FlyingEnemy>& flyers,
-                 std::vector<entities::Worm>& worms,
+                 ZombiePool& zombies,
+                 FlyerPool& flyers,
+                 WormPool& worms,
                  entities::Dragon* dragon,
                  EnemyManager& enemyManager);
 
-    void update(float dt);
+    // Adds live projectiles to this step's bodies; resolve applies the moved bodies and lands hits.
+    void update(float dt, BodyStore& bodies);
+    void resolve(float dt, const BodyStore& bodies);
     void startSwordSwing(float angleStart, float angleEnd, entities::ToolTier swordTier);
     void spawnProjectile(const entities::Vec2& direction,
                          entities::ToolTier tier,
@@ -36,7 +38,9 @@ public:
                          float speedScale = 1.0F,
                          float gravityScale = 1.0F);
     void reset();
-    void fillHud(rendering::HudState& hud) const;
+    void hashState(StateHasher& hasher) const;
+    void storePreviousPositions();
+    void fillHud(rendering::HudState& hud, float alpha) const;
 
 private:
     struct SwordSwingState {
@@ -54,36 +58,42 @@ private:
 
     struct Projectile {
         entities::Vec2 position{};
+        entities::Vec2 previousPosition{};
         entities::Vec2 velocity{};
         float lifetime{0.0F};
         float radius{0.2F};
         int damage{0};
         float gravityScale{1.0F};
+        int body{kNoBody};
     };
 
     int swordDamageForTier(entities::ToolTier tier) const;
     int rangedDamageForTier(entities::ToolTier tier) const;
     void updateSwordSwing(float dt);
-    void updateProjectiles(float dt);
-    void damageZombie(entities::Zombie& zombie, int amount, float knockbackDir);
-    void damageFlyer(entities::FlyingEnemy& flyer, int amount, float knockbackDir);
-    void damageWorm(entities::Worm& worm, int amount, float knockbackDir);
+    void resolveProjectiles(const BodyStore& bodies);
+    // Applies a projectile hit to one collider; false when the target is already gone.
+    bool strikeTarget(const Projectile& projectile, const Collider& collider);
+    void damageZombie(std::size_t index, int amount, float knockbackDir);
+    void damageFlyer(std::size_t index, int amount, float knockbackDir);
+    void damageWorm(std::size_t index, int amount, float knockbackDir);
     void damageDragon(entities::Dragon& dragon, int amount, float knockbackDir);
 
     world::World& world_;
     entities::Player& player_;
     PhysicsSystem& physics_;
     DamageNumberSystem& damageNumbers_;
-    std::vector<entities::Zombie>& zombies_;
-    std::vector<entities::FlyingEnemy>& flyers_;
-    std::vector<entities::Worm>& worms_;
+    ZombiePool& zombies_;
+    FlyerPool& flyers_;
+    WormPool& worms_;
     entities::Dragon* dragon_{nullptr};
     EnemyManager& enemyManager_;
     SwordSwingState swordSwing_{};
-    std::vector<int> swordSwingHitIds_{};
-    std::vector<int> swordSwingHitFlyerIds_{};
+    std::vector<EnemyHandle> swordSwingHitZombies_{};
+    std::vector<EnemyHandle> swordSwingHitFlyers_{};
     bool swordSwingHitDragon_{false};
     std::vector<Projectile> projectiles_{};
+    std::vector<int> hits_{};
+    std::vector<SegmentHit> segmentHits_{};
 };
 
 } // namespace terraria::game
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "terraria/entities/Player.h"
+#include "terraria/world/World.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace terraria::game {
+
+// Append-only log of tile edits and player state between checkpoints. Records are buffered and
+// written plus fsynced by a background thread every flush interval. Each checkpoint rotates to a
+// new segment file; segments are deleted once the checkpoint that covers them is on disk. The
+// caller only seals buffers and queues deletions; all file work happens on the background thread.
+class EditLog {
+public:
+    explicit EditLog(int flushIntervalMs = 250);
+    ~EditLog();
+
+    EditLog(const EditLog&) = delete;
+    EditLog& operator=(const EditLog&) = delete;
+
+    bool open(const std::filesystem::path& directory, const std::string& name);
+    void close();
+    bool isOpen() const { return open_; }
+
+    void appendTile(int x, int y, std::uint8_t cell);
+    // Logs health and inventory when they differ from the last logged state.
+    void appendPlayer(const entities::Player& player);
+
+    // Seals the records logged so far into the current segment and returns its generation.
+    std::uint64_t rotate();
+    void discardThrough(std::uint64_t generation);
+
+    // Applies every surviving segment for name, oldest first. Returns true if anything was applied.
+    static bool replay(const std::filesystem::path& directory,
+                       const std::string& name,
+                       world::World* world,
+                       entities::Player* player);
+
+private:
+    struct SealedSegment {
+        std::uint64_t generation{0};
+        std::vector<std::uint8_t> tail{};
+    };
+
+    struct PlayerRecord {
+        int health{0};
+        std::array<entities::InventorySlot, entities::kInventorySlots> inventory{};
+        entities::InventorySlot ammo{};
+    };
+
+    static std::vector<std::pair<std::uint64_t, std::filesystem::path>> segments(const std::filesystem::path& directory,
+                                                                                 const std::string& name);
+    std::filesystem::path segmentPath(std::uint64_t generation) const;
+    bool openSegment(std::uint64_t generation);
+    void drain();
+    void flushLoop();
+
+    int flushIntervalMs_{250};
+    std::filesystem::path directory_{};
+    std::string name_{};
+    std::uint64_t generation_{0};
+    bool open_{false};
+    // Owned by the flusher thread while it runs.
+    std::FILE* file_{nullptr};
+    std::uint64_t fileGeneration_{0};
+
+    std::mutex bufferMutex_{};
+    std::condition_variable wake_{};
+    std::vector<std::uint8_t> pending_{};
+    std::vector<SealedSegment> sealed_{};
+    std::uint64_t discardThrough_{0};
+    std::uint64_t discarded_{0};
+    bool stopping_{false};
+    std::thread flusher_{};
+
+    bool hasPlayerRecord_{false};
+    PlayerRecord lastPlayer_{};
+};
+
+} // namespace terraria::game
@@ -1,13 +1,15 @@
 #pragma once
 
 #include "terraria/core/Application.h"
+#include "terraria/core/Random.h"
 #include "terraria/entities/Dragon.h"
-#include "terraria/entities/FlyingEnemy.h"
 #include "terraria/entities/Player.h"
-#include "terraria/entities/Worm.h"
-#include "terraria/entities/Zombie.h"
 #include "terraria/game/DamageNumberSystem.h"
+#include "terraria/game/EnemyPool.h"
+#include "terraria/game/FlowField.h"
 #include "terraria/game/PhysicsSystem.h"
+#include "terraria/game/SpatialHash.h"
+#include "terraria/game/StateHash.h"
 #include "terraria/rendering/HudState.h"
 #include "terraria/world/World.h"
 
@@ -24,19 +26,36 @@ public:
                  PhysicsSystem& physics,
                  DamageNumberSystem& damageNumbers);
 
-    void update(float dt, bool isNight, const entities::Vec2& cameraFocus);
+    // Behavior pass: steers every enemy and adds its body for this step.
+    void update(float dt, bool isNight, const entities::Vec2& cameraFocus, BodyStore& bodies);
+    // Applies the moved bodies, then runs contacts and attacks and drops the dead.
+    void resolve(bool isNight, const BodyStore& bodies);
     void reset();
-    void fillHud(rendering::HudState& hud) const;
+    // Reseeds the spawn, loot and attack random streams independently of each other.
+    void seed(std::uint64_t seed);
+    void hashState(StateHasher& hasher) const;
+    void storePreviousPositions();
+    // alpha blends each entity between its previous and current simulation position.
+    void fillHud(rendering::HudState& hud, float alpha) const;
     bool removeEnemyProjectilesInBox(const entities::Vec2& center, float halfWidth, float halfHeight);
-    bool removeEnemyProjectileAt(const entities::Vec2& position, float radius);
+    // index is a ColliderKind::EnemyProjectile collider index; dragon fire cannot be shot down.
+    bool removeEnemyProjectile(int index);
+    // Enemies and enemy projectiles as of the last resolve; indices point into the containers below.
+    const SpatialHash& colliders() const { return colliders_; }
     void setDragonDen(const entities::Vec2& center, float radiusX, float radiusY);
+    // Place one enemy directly, ignoring caps and spawn timers; false when the spot is unsuitable.
+    bool spawnZombieAt(const entities::Vec2& feet);
+    bool spawnFlyerAt(const entities::Vec2& position);
+    bool spawnWormAt(const entities::Vec2& position);
 
-    std::vector<entities::Zombie>& zombies() { return zombies_; }
-    const std::vector<entities::Zombie>& zombies() const { return zombies_; }
-    std::vector<entities::FlyingEnemy>& flyers() { return flyers_; }
-    const std::vector<entities::FlyingEnemy>& flyers() const { return flyers_; }
-    std::vector<entities::Worm>& worms() { return worms_; }
-    const std::vector<entities::Worm>& worms() const { return worms_; }
+    ZombiePool& zombies() { return zombies_; }
+    const ZombiePool& zombies() const { return zombies_; }
+    FlyerPool& flyers() { return flyers_; }
+    const FlyerPool& flyers() const { return flyers_; }
+    WormPool& worms() { return worms_; }
+    const WormPool& worms() const { return worms_; }
+    // Living enemies of every kind, the dragon included while it is out.
+    std::size_t enemyCount() const;
     entities::Dragon* dragon() { return &dragon_; }
     const entities::Dragon* dragon() const { return &dragon_; }
 
@@ -50,43 +69,54 @@ private:
 
     struct EnemyProjectile {
         entities::Vec2 position{};
+        entities::Vec2 previousPosition{};
         entities::Vec2 velocity{};
         float lifetime{0.0F};
         float radius{0.2F};
         int damage{0};
         bool isFlame{false};
         bool fromDragon{false};
+        int body{kNoBody};
     };
 
     ViewBounds computeViewBounds(const entities::Vec2& cameraFocus) const;
+    bool nearView(const entities::Vec2& position) const;
 
-    void updateZombies(float dt, bool isNight, const ViewBounds& view);
-    void updateFlyers(float dt, bool isNight, const ViewBounds& view);
-    void updateWorms(float dt, const ViewBounds& view);
-    void updateDragon(float dt);
-    void updateEnemyProjectiles(float dt);
+    void updateZombies(float dt, bool isNight, const ViewBounds& view, BodyStore& bodies);
+    void updateFlyers(float dt, bool isNight, const ViewBounds& view, BodyStore& bodies);
+    void updateWorms(float dt, const ViewBounds& view, BodyStore& bodies);
+    void updateDragon(float dt, BodyStore& bodies);
+    void updateEnemyProjectiles(float dt, BodyStore& bodies);
+    void resolveZombies(bool isNight, const BodyStore& bodies);
+    void resolveFlyers(bool isNight, const BodyStore& bodies);
+    void resolveWorms(const BodyStore& bodies);
+    void resolveDragon(const BodyStore& bodies);
+    void resolveEnemyProjectiles(const BodyStore& bodies);
 
     void spawnZombie(const ViewBounds& view);
     void spawnFlyer(const ViewBounds& view);
     void spawnWorm(const ViewBounds& view);
     void spawnDragon();
 
-    int computeZombiePathDirection(const entities::Zombie& zombie) const;
-    bool isWalkableSpot(int x, int footY) const;
-    bool pathClear(int startX, int endX, int footY) const;
-    void applyZombiePhysics(entities::Zombie& zombie, float dt);
+    void steerZombie(std::size_t index, float dt);
+    void indexColliders();
 
     const core::AppConfig& config_;
     world::World& world_;
     entities::Player& player_;
     PhysicsSystem& physics_;
     DamageNumberSystem& damageNumbers_;
-    std::vector<entities::Zombie> zombies_{};
-    std::vector<entities::FlyingEnemy> flyers_{};
-    std::vector<entities::Worm> worms_{};
+    ZombiePool zombies_{};
+    FlyerPool flyers_{};
+    WormPool worms_{};
     entities::Dragon dragon_{};
-    std::vector<EnemyProjectile> enemyProjectiles_{};
-    std::mt19937 rng_{};
+    EnemyList<EnemyProjectile> enemyProjectiles_{};
+    SpatialHash colliders_{};
+    FlowField flowField_;
+    std::vector<int> queryResults_{};
+    std::mt19937 spawnRng_{};
+    std::mt19937 lootRng_{};
+    std::mt19937 attackRng_{};
     float spawnTimerZombies_{0.0F};
     float spawnTimerFlyers_{0.0F};
     float spawnTimerWorms_{0.0F};
@@ -94,6 +124,7 @@ private:
     int nextFlyerId_{1};
     int nextWormId_{1};
     float swoopTimer_{0.0F};
+    ViewBounds view_{};
     bool dragonActive_{false};
     bool dragonSpawned_{false};
     bool dragonDefeated_{false};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "terraria/core/MemoryTags.h"
+#include "terraria/entities/FlyingEnemy.h"
+#include "terraria/entities/Vec2.h"
+#include "terraria/entities/Worm.h"
+#include "terraria/entities/Zombie.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace terraria::game {
+
+template <typename T>
+using EnemyList = core::TrackedVector<T, core::MemoryTag::Enemies>;
+
+// Refers to one pooled enemy for as long as it lives; once it is removed the handle stops resolving,
+// even after its slot is reused.
+struct EnemyHandle {
+    static constexpr std::uint32_t kNoSlot = 0xFFFFFFFFU;
+
+    std::uint32_t slot{kNoSlot};
+    std::uint32_t generation{0};
+
+    bool operator==(const EnemyHandle&) const = default;
+};
+
+// Enemies of one kind in structure-of-arrays layout, indexed densely from 0 to size(). The public hot
+// arrays are what every step touches (movement, bodies, colliders, hashing, interpolation); State is
+// the kind's AI timers and flags, read only by its own behavior. Removal moves the last enemy into the
+// hole, so dense indices are only stable between removals; hold an EnemyHandle across them instead.
+// Resize the arrays only through add, removeAt and clear.
+template <typename State>
+class EnemyPool {
+public:
+    EnemyList<entities::Vec2> position{};
+    EnemyList<entities::Vec2> previousPosition{};
+    EnemyList<entities::Vec2> velocity{};
+    EnemyList<int> health{};
+    EnemyList<int> body{}; // index into the current step's BodyStore
+    EnemyList<int> id{};
+    EnemyList<State> state{};
+
+    std::size_t size() const { return position.size(); }
+    bool empty() const { return position.empty(); }
+    bool alive(std::size_t index) const { return health[index] > 0; }
+
+    EnemyHandle add(const entities::Vec2& at, int hitPoints, int enemyId, const State& initial) {
+        std::uint32_t slot = 0;
+        if (freeSlots_.empty()) {
+            slot = static_cast<std::uint32_t>(dense_.size());
+            dense_.push_back(0);
+            generations_.push_back(0);
+        } else {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+        dense_[slot] = static_cast<std::uint32_t>(size());
+        slots_.push_back(slot);
+        position.push_back(at);
+        previousPosition.push_back(at);
+        velocity.push_back({0.0F, 0.0F});
+        health.push_back(hitPoints);
+        body.push_back(-1);
+        id.push_back(enemyId);
+        state.push_back(initial);
+        return {slot, generations_[slot]};
+    }
+
+    void removeAt(std::size_t index) {
+        const std::uint32_t slot = slots_[index];
+        ++generations_[slot];
+        freeSlots_.push_back(slot);
+        const std::size_t last = size() - 1;
+        if (index != last) {
+            position[index] = position[last];
+            previousPosition[index] = previousPosition[last];
+            velocity[index] = velocity[last];
+            health[index] = health[last];
+            body[index] = body[last];
+            id[index] = id[last];
+            state[index] = state[last];
+            slots_[index] = slots_[last];
+            dense_[slots_[index]] = static_cast<std::uint32_t>(index);
+        }
+        position.pop_back();
+        previousPosition.pop_back();
+        velocity.pop_back();
+        health.pop_back();
+        body.pop_back();
+        id.pop_back();
+        state.pop_back();
+        slots_.pop_back();
+    }
+
+    // Drops every enemy with no health left; survivors keep their handles but may change index.
+    void removeDead() {
+        for (std::size_t index = 0; index < size();) {
+            if (alive(index)) {
+                ++index;
+            } else {
+                removeAt(index);
+            }
+        }
+    }
+
+    void clear() {
+        for (const std::uint32_t slot : slots_) {
+            ++generations_[slot];
+            freeSlots_.push_back(slot);
+        }
+        position.clear();
+        previousPosition.clear();
+        velocity.clear();
+        health.clear();
+        body.clear();
+        id.clear();
+        state.clear();
+        slots_.clear();
+    }
+
+    void reserve(std::size_t count) {
+        position.reserve(count);
+        previousPosition.reserve(count);
+        velocity.reserve(count);
+        health.reserve(count);
+        body.reserve(count);
+        id.reserve(count);
+        state.reserve(count);
+        slots_.reserve(count);
+    }
+
+    EnemyHandle handle(std::size_t index) const {
+        const std::uint32_t slot = slots_[index];
+        return {slot, generations_[slot]};
+    }
+
+    // Dense index of the handle's enemy, or -1 once it has been removed.
+    int find(EnemyHandle handle) const {
+        if (handle.slot >= generations_.size() || generations_[handle.slot] != handle.generation) {
+            return -1;
+        }
+        return static_cast<int>(dense_[handle.slot]);
+    }
+
+private:
+    EnemyList<std::uint32_t> slots_{};       // dense index -> slot
+    EnemyList<std::uint32_t> dense_{};       // slot -> dense index while the slot is live
+    EnemyList<std::uint32_t> generations_{}; // slot -> generation of its current or next occupant
+    EnemyList<std::uint32_t> freeSlots_{};
+};
+
+using ZombiePool = EnemyPool<entities::Zombie>;
+using FlyerPool = EnemyPool<entities::FlyingEnemy>;
+using WormPool = EnemyPool<entities::Worm>;
+
+} // namespace terraria::game
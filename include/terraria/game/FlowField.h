@@ -0,0 +1,73 @@
+#pragma once
+
+#include "terraria/core/MemoryTags.h"
+#include "terraria/entities/Vec2.h"
+#include "terraria/game/PhysicsSystem.h"
+#include "terraria/world/World.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace terraria::game {
+
+// Walking directions toward one target for every ground enemy at once. Nodes are stand cells: a clear
+// feet row and head row over a solid tile, keyed by the feet row (floor of a resting body's y). A move
+// goes one column sideways as a walk, a climb of up to kMaxClimb rows with headroom above the start, or
+// a walk off a ledge onto the first floor within kMaxDrop rows. Dijkstra runs backwards from the target
+// over a window around it and keeps which way each cell should step. The window is recomputed only when
+// the target's stand cell changes or a chunk under it is edited (seen through World::chunkHash).
+class FlowField {
+public:
+    static constexpr int kRadiusX = 64;
+    static constexpr int kRadiusY = 32;
+    static constexpr int kMaxClimb = 3;
+    static constexpr int kMaxDrop = 12;
+
+    FlowField(const world::World& world, const PhysicsSystem& physics);
+
+    // Recomputes the field when needed; a target with no floor within kMaxDrop rows keeps the old one.
+    void update(const entities::Vec2& target);
+    void clear();
+
+    // -1 or 1 toward the target; 0 at the target's cell, outside the window or with no walkable route.
+    int direction(const entities::Vec2& feet) const;
+    // Path cost to the target: kWalkCost per column, plus kClimbCostPerRow per row climbed or
+    // kDropCostPerRow per row dropped (see FlowField.cpp); -1 when unknown.
+    int cost(const entities::Vec2& feet) const;
+    std::uint64_t rebuilds() const { return rebuilds_; }
+
+private:
+    static constexpr std::uint16_t kUnreached = 0xFFFF;
+
+    bool findStandCell(const entities::Vec2& feet, int& x, int& y) const;
+    bool chunksChanged() const;
+    void rebuild(int goalX, int goalY);
+    bool solid(int localX, int localY) const;
+    bool standable(int localX, int localY) const;
+    void relax(int localX, int localY, int cost, std::int8_t step);
+    int localIndex(const entities::Vec2& feet) const;
+
+    const world::World& world_;
+    const PhysicsSystem& physics_;
+    bool valid_{false};
+    int goalX_{0};
+    int goalY_{0};
+    int originX_{0};
+    int originY_{0};
+    int width_{0};
+    int height_{0};
+    int chunkX0_{0};
+    int chunkY0_{0};
+    int chunkX1_{-1};
+    int chunkY1_{-1};
+    int chunksX_{0};
+    std::uint64_t rebuilds_{0};
+    std::vector<std::uint64_t> chunkHashes_{};
+    core::TrackedVector<std::uint8_t, core::MemoryTag::Enemies> solid_{};
+    core::TrackedVector<std::uint16_t, core::MemoryTag::Enemies> cost_{};
+    core::TrackedVector<std::int8_t, core::MemoryTag::Enemies> step_{};
+    // Min-heap of (cost << 32 | cell) entries; stale ones are skipped when popped.
+    core::TrackedVector<std::uint64_t, core::MemoryTag::Enemies> open_{};
+};
+
+} // namespace terraria::game
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "terraria/core/Application.h"
+#include "terraria/core/FrameArena.h"
+#include "terraria/core/FrameStats.h"
 #include "terraria/entities/Player.h"
 #include "terraria/entities/Tools.h"
+#include "terraria/game/AutosaveService.h"
 #include "terraria/game/CombatSystem.h"
 #include "terraria/game/CraftingSystem.h"
 #include "terraria/game/ChatConsole.h"
 #include "terraria/game/DamageNumberSystem.h"
+#include "terraria/game/EditLog.h"
 #include "terraria/game/EnemyManager.h"
 #include "terraria/game/InventorySystem.h"
 #include "terraria/game/MenuSystem.h"
@@ -19,6 +23,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <fstream>
 #include <vector>
 #include <string>
 
@@ -29,15 +34,23 @@ public:
     explicit Game(const core::AppConfig& config);
 
     void initialize();
-    bool tick();
+    // Advances the simulation in fixed steps covering frameSeconds of real time, then renders once.
+    bool tick(float frameSeconds);
     void shutdown();
 
 private:
-    void handleInput();
+    void handleInput(float frameSeconds);
+    // Zoom, pan and drag of the fullscreen map; applied once per frame, not per simulation step.
+    void updateFullscreenMap(const input::InputState& inputState, float frameSeconds);
     void update(float dt);
     void render();
+    void processInterfaceInput();
     void processActions(float dt);
+    void storePreviousState();
+    void stepSimulation();
+    void recordStateHash();
     void saveActiveSession();
+    void pollAutosave();
     void clearActiveSession();
     void loadOrCreateSaves();
     void startSession(const WorldInfo& worldInfo, const CharacterInfo& characterInfo);
@@ -55,12 +68,14 @@ private:
     void updateHudState();
     void toggleCameraMode();
     void revealExploredTiles();
-    std::string currentMapKey() const;
+    const std::string& currentMapKey() const { return mapKey_; }
     entities::Vec2 cameraFocus() const;
     entities::Vec2 clampCameraTarget(const entities::Vec2& desired) const;
     static bool isTreeTile(world::TileType type);
     void updateDayNight(float dt);
     float normalizedTimeOfDay() const;
+    void finishTraceFrame();
+    void logHitch(float workMs, float frameMs);
     void recordPerformanceMetrics(float frameMs, float updateMs, float renderMs);
     entities::ToolTier selectedToolTier(entities::ToolKind kind) const;
     bool hasRequiredTool(world::TileType tileType) const;
@@ -79,6 +94,8 @@ private:
     world::WorldGenerator generator_;
     entities::Player player_;
     PhysicsSystem physics_;
+    BodyStore bodies_{};
+    int playerBody_{kNoBody};
     DamageNumberSystem damageNumbers_{};
     EnemyManager enemyManager_;
     CombatSystem combatSystem_;
@@ -99,6 +116,8 @@ private:
     float dayLength_{180.0F};
     bool isNight_{false};
     std::uint32_t worldSeed_{0};
+    std::string mapKey_{};
+    world::WorldGenerator::WorldGenConfig worldGenConfig_{};
     entities::Vec2 worldSpawn_{};
     float moveInput_{0.0F};
     float jumpBufferTimer_{0.0F};
@@ -110,6 +129,39 @@ private:
     float perfUpdateTimeMs_{0.0F};
     float perfRenderTimeMs_{0.0F};
     float perfFps_{0.0F};
+    // Wall time per system in the current frame, summed over its simulation steps; logged with hitches.
+    struct SystemTimes {
+        float input{0.0F};
+        float enemies{0.0F};
+        float combat{0.0F};
+        float physics{0.0F};
+        float explore{0.0F};
+        float actions{0.0F};
+        float stateHash{0.0F};
+        float autosave{0.0F};
+        float hud{0.0F};
+        float render{0.0F};
+        int steps{0};
+    };
+    SystemTimes systemTimes_{};
+    double perfClockSeconds_{0.0};
+    core::RollingHistogram frameTimes_;
+    core::RollingHistogram updateTimes_;
+    core::RollingHistogram renderTimes_;
+    bool perfExpanded_{false};
+    std::uint64_t frameIndex_{0};
+    std::uint32_t hitchCount_{0};
+    std::ofstream hitchLog_{};
+    float simulationStep_{1.0F / 60.0F};
+    float accumulator_{0.0F};
+    float renderAlpha_{1.0F};
+    std::uint64_t simulationTick_{0};
+    std::uint64_t stateHash_{0};
+    std::uint64_t lastLoggedTick_{0};
+    std::uint64_t frameHeapAllocations_{0};
+    std::uint64_t heapAllocationsSinceLog_{0};
+    core::FrameArena frameArena_{};
+    std::vector<std::uint8_t> fogScratch_{};
     float bowDrawTimer_{0.0F};
     bool paused_{false};
     bool requestQuit_{false};
@@ -120,6 +172,17 @@ private:
     float minimapCenterY_{0.0F};
     ChatConsole chatConsole_{};
     SaveManager saveManager_{};
+    AutosaveService autosave_;
+    bool saveNoticePending_{false};
+    struct PendingCheckpoint {
+        std::uint64_t tag{0};
+        std::uint64_t worldGeneration{0};
+        std::uint64_t playerGeneration{0};
+    };
+    EditLog worldLog_;
+    EditLog playerLog_;
+    std::uint64_t checkpointTag_{0};
+    std::vector<PendingCheckpoint> pendingCheckpoints_{};
     MenuSystem menuSystem_{};
     std::vector<CharacterInfo> characterList_{};
     std::vector<WorldInfo> worldList_{};
@@ -1,10 +1,44 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
+
 #include "terraria/entities/Vec2.h"
+#include "terraria/game/BodyStore.h"
 #include "terraria/world/World.h"
 
 namespace terraria::game {
 
+struct SweepHit {
+    bool hit{false};
+    float time{1.0F}; // fraction of the displacement covered before contact
+    entities::Vec2 normal{};
+};
+
+// One bit per world::TileType; a ray stops on active tiles whose bit is set.
+using TileMask = std::uint32_t;
+
+constexpr TileMask TileBit(world::TileType type) {
+    return TileMask{1} << static_cast<unsigned>(type);
+}
+
+constexpr TileMask kAnyTileMask = ~TileBit(world::TileType::Air);
+
+struct Ray {
+    entities::Vec2 origin{};
+    entities::Vec2 direction{}; // need not be normalized
+    float maxDistance{0.0F};
+};
+
+struct RayHit {
+    bool hit{false};
+    int tileX{0};
+    int tileY{0};
+    float distance{0.0F}; // in tiles along the ray; maxDistance when nothing was hit
+    entities::Vec2 point{};
+    entities::Vec2 normal{}; // face entered; zero when the ray starts inside the tile
+};
+
 class PhysicsSystem {
 public:
     explicit PhysicsSystem(const world::World& world);
@@ -28,6 +62,37 @@ public:
                              bool& onGround) const;
     bool solidAtPosition(const entities::Vec2& pos) const;
 
+    // Boxes are feet-anchored like collidesAabb; a zero-sized box sweeps a point. Tiles the box
+    // already overlaps are ignored so an embedded box can still move out.
+    SweepHit sweepAabb(const entities::Vec2& position,
+                       float halfWidth,
+                       float height,
+                       const entities::Vec2& displacement) const;
+    // Integrates velocity over dt against the tile grid, substepping so no step crosses more than one
+    // tile. Replaces a resolveHorizontalAabb/resolveVerticalAabb pair.
+    void moveAabb(entities::Vec2& position,
+                  entities::Vec2& velocity,
+                  float halfWidth,
+                  float height,
+                  float dt,
+                  bool& onGround) const;
+    static int SubstepsFor(const entities::Vec2& displacement);
+    // Applies gravity, integrates and resolves every body in the store, then clamps to each body's bounds.
+    void step(BodyStore& bodies, float dt) const;
+
+    // Tiles that block movement, derived from the tile classes.
+    static TileMask SolidTileMask();
+    // Walks the grid cell by cell (Amanatides-Woo). Cells above the world are open sky; the sides and
+    // bottom count as solid whatever stopMask says, as in isSolidTile, so a ray leaving there hits the
+    // outside cell (tileX/tileY out of range) on the boundary face.
+    RayHit raycast(const entities::Vec2& origin,
+                   const entities::Vec2& direction,
+                   float maxDistance,
+                   TileMask stopMask = SolidTileMask()) const;
+    bool lineOfSight(const entities::Vec2& from, const entities::Vec2& to) const;
+    // hits must be at least as long as rays.
+    void raycastBatch(std::span<const Ray> rays, std::span<RayHit> hits, TileMask stopMask = SolidTileMask()) const;
+
 private:
     const world::World& world_;
 };
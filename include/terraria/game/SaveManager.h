@@ -1,12 +1,17 @@
 #pragma once
 
+#include "terraria/core/MemoryTags.h"
 #include "terraria/entities/Player.h"
 #include "terraria/world/World.h"
+#include "terraria/world/WorldGenerator.h"
 
 #include <filesystem>
 #include <cstdint>
 #include <array>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace terraria::game {
@@ -29,22 +34,59 @@ struct WorldInfo {
     float spawnY{0.0F};
 };
 
+// World bodies copied for saving, compressed blocks and the cached generated baseline.
+using SaveBuffer = core::TrackedVector<std::uint8_t, core::MemoryTag::SaveBuffers>;
+
+struct WorldSnapshot {
+    std::string id{};
+    std::string name{};
+    int width{0};
+    int height{0};
+    std::uint32_t seed{0};
+    world::WorldGenerator::WorldGenConfig genConfig{};
+    float spawnX{0.0F};
+    float spawnY{0.0F};
+    float timeOfDay{0.0F};
+    bool isNight{false};
+    SaveBuffer tiles{}; // packed cells in World chunk layout
+    std::vector<std::uint64_t> chunkHashes{}; // world::ChunkHash of each chunk in tiles
+};
+
+struct CharacterSnapshot {
+    std::string id{};
+    std::string name{};
+    entities::Player player{};
+};
+
 class SaveManager {
 public:
+    // Raw bodies can be memory-mapped, Delta stores chunks that differ from the seed's generate()
+    // output, Blocks stores independently compressed chunk runs encoded and decoded in parallel.
+    enum class WorldEncoding : std::uint8_t {
+        Raw = 0,
+        Delta = 1,
+        Blocks = 2
+    };
+
     explicit SaveManager(std::filesystem::path basePath = "saves");
 
     void ensureDirectories() const;
+    std::filesystem::path editLogDir() const;
+    void setWorldEncoding(WorldEncoding encoding) { worldEncoding_ = encoding; }
+    void setWorkerThreads(int threads) { workerThreads_ = threads; }
 
     std::vector<CharacterInfo> listCharacters() const;
     std::vector<WorldInfo> listWorlds() const;
 
     bool loadCharacter(const std::string& id, entities::Player& player, std::string& outName) const;
     bool saveCharacter(const std::string& id, const std::string& name, const entities::Player& player) const;
+    bool loadExploredMap(const std::string& characterId, const std::string& mapKey, entities::Player& player) const;
 
     bool loadWorld(const std::string& id,
                    world::World& world,
                    std::string& outName,
                    std::uint32_t& seed,
+                   world::WorldGenerator::WorldGenConfig& genConfig,
                    float& spawnX,
                    float& spawnY,
                    float& timeOfDay,
@@ -53,10 +95,30 @@ public:
                    const std::string& name,
                    const world::World& world,
                    std::uint32_t seed,
+                   const world::WorldGenerator::WorldGenConfig& genConfig,
                    float spawnX,
                    float spawnY,
                    float timeOfDay,
                    bool isNight) const;
+    bool saveWorld(const WorldSnapshot& snapshot) const;
+    // Recomputes every chunk hash from the stored cells and compares it with the save's chunk table.
+    // Returns false if the save cannot be read, predates chunk hashes, or any chunk mismatches.
+    bool verifyWorld(const std::string& id, std::vector<std::size_t>& mismatchedChunks) const;
+    // Reads only the header and chunk table of a world file.
+    static bool readChunkHashes(const std::filesystem::path& path,
+                                int& width,
+                                int& height,
+                                std::vector<std::uint64_t>& hashes);
+
+    static WorldSnapshot snapshotWorld(const std::string& id,
+                                       const std::string& name,
+                                       const world::World& world,
+                                       std::uint32_t seed,
+                                       const world::WorldGenerator::WorldGenConfig& genConfig,
+                                       float spawnX,
+                                       float spawnY,
+                                       float timeOfDay,
+                                       bool isNight);
 
     std::string createCharacterId(const std::vector<CharacterInfo>& existing) const;
     std::string createWorldId(const std::vector<WorldInfo>& existing) const;
@@ -66,12 +128,62 @@ public:
 private:
     std::filesystem::path charactersDir() const;
     std::filesystem::path worldsDir() const;
+    std::filesystem::path mapsDir(const std::string& characterId) const;
 
     bool readCharacterHeader(const std::filesystem::path& path, CharacterInfo& info) const;
     bool readWorldHeader(const std::filesystem::path& path, WorldInfo& info) const;
     std::string makeId(const std::string& prefix, int index) const;
+    bool commitTempFile(const std::filesystem::path& tempPath, const std::filesystem::path& path) const;
+    bool saveExploredMaps(const std::string& characterId, const entities::Player& player) const;
+    std::shared_ptr<const SaveBuffer> generatedBaseline(int width,
+                                                                       int height,
+                                                                       std::uint32_t seed,
+                                                                       const world::WorldGenerator::WorldGenConfig& genConfig) const;
+
+    struct IndexedCharacter {
+        CharacterInfo info{};
+        std::int64_t modified{0};
+        std::uint64_t size{0};
+    };
+
+    struct IndexedWorld {
+        WorldInfo info{};
+        std::int64_t modified{0};
+        std::uint64_t size{0};
+    };
+
+    // Cached headers of every save, persisted to index.bin so menus can list without opening saves.
+    struct SaveIndex {
+        bool loaded{false};
+        std::int64_t charactersDirModified{0};
+        std::int64_t worldsDirModified{0};
+        std::vector<IndexedCharacter> characters{};
+        std::vector<IndexedWorld> worlds{};
+    };
+
+    std::filesystem::path indexPath() const;
+    void loadIndex() const;
+    void writeIndex() const;
+    void indexCharacter(const std::filesystem::path& path, std::int64_t dirModifiedBefore) const;
+    void indexWorld(const std::filesystem::path& path, std::int64_t dirModifiedBefore) const;
 
     std::filesystem::path basePath_;
+    mutable std::mutex indexMutex_{};
+    mutable SaveIndex index_{};
+    mutable std::mutex mapMutex_{};
+    mutable std::unordered_map<std::string, std::uint32_t> savedMapRevisions_{};
+    WorldEncoding worldEncoding_{WorldEncoding::Raw};
+    int workerThreads_{1};
+
+    struct GeneratedBaseline {
+        int width{0};
+        int height{0};
+        std::uint32_t seed{0};
+        world::WorldGenerator::WorldGenConfig genConfig{};
+        std::shared_ptr<const SaveBuffer> cells{};
+    };
+    mutable std::mutex baselineMutex_{};
+    mutable GeneratedBaseline baseline_{};
 };
 
 } // namespace terraria::game
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "terraria/entities/Vec2.h"
+
+namespace terraria::game {
+
+enum class ColliderKind : std::uint8_t {
+    Zombie,
+    Flyer,
+    Worm,
+    Dragon,
+    EnemyProjectile
+};
+
+using ColliderMask = std::uint32_t;
+
+constexpr ColliderMask ColliderBit(ColliderKind kind) {
+    return ColliderMask{1} << static_cast<unsigned>(kind);
+}
+
+inline constexpr ColliderMask kEnemyColliders = ColliderBit(ColliderKind::Zombie) | ColliderBit(ColliderKind::Flyer)
+    | ColliderBit(ColliderKind::Worm) | ColliderBit(ColliderKind::Dragon);
+
+// Boxes are feet-anchored like PhysicsSystem::aabbOverlap: x in [left, right], y in [top, bottom].
+struct Collider {
+    ColliderKind kind{ColliderKind::Zombie};
+    int index{0}; // into the owning system's container
+    float left{0.0F};
+    float top{0.0F};
+    float right{0.0F};
+    float bottom{0.0F};
+};
+
+struct SegmentHit {
+    int collider{0};
+    float time{0.0F}; // fraction of the segment at first contact
+};
+
+// Uniform-grid broadphase rebuilt once per step: insert every collider, build, then query. A collider
+// lands in each cell it touches; build counting-sorts the (cell, collider) entries into hashed buckets,
+// so both building and finding a cell take constant time per entry however many colliders there are,
+// and rebuilding reuses the storage. Query results are collider ids in insertion order with exact
+// overlap already applied.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 4.0F);
+
+    void clear();
+    int insert(ColliderKind kind, int index, const entities::Vec2& position, float halfWidth, float height);
+    void build();
+
+    const Collider& collider(int id) const { return colliders_[static_cast<std::size_t>(id)]; }
+    std::size_t size() const { return colliders_.size(); }
+
+    void queryBox(const entities::Vec2& position,
+                  float halfWidth,
+                  float height,
+                  ColliderMask mask,
+                  std::vector<int>& out) const;
+    void queryCircle(const entities::Vec2& center, float radius, ColliderMask mask, std::vector<int>& out) const;
+    // Sweeps a feet-anchored box from one position to another; hits come back ordered by contact time.
+    void querySegment(const entities::Vec2& from,
+                      const entities::Vec2& to,
+                      float halfWidth,
+                      float height,
+                      ColliderMask mask,
+                      std::vector<SegmentHit>& out) const;
+
+private:
+    struct CellEntry {
+        std::int64_t cell{0};
+        int collider{0};
+    };
+
+    int cellOf(float coordinate) const;
+    static std::int64_t cellKey(int cellX, int cellY);
+    std::size_t bucketOf(std::int64_t key) const;
+    // Calls visit(colliderId) once per collider in mask touching the cell range.
+    template <typename Visit>
+    void forEachCandidate(float left, float top, float right, float bottom, ColliderMask mask, Visit&& visit) const;
+
+    float cellSize_;
+    float inverseCellSize_;
+    std::vector<Collider> colliders_{};
+    std::vector<CellEntry> entries_{};  // grouped by bucket, ascending collider id within each
+    std::vector<CellEntry> scratch_{};
+    std::vector<std::uint32_t> bucketStart_{}; // bucket -> first entry; one extra end marker
+    int bucketShift_{64};
+    mutable std::vector<std::uint32_t> visited_{};
+    mutable std::uint32_t queryStamp_{0};
+};
+
+} // namespace terraria::game
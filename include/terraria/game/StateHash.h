@@ -0,0 +1,29 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include "terraria/core/Random.h"
+#include "terraria/entities/Vec2.h"
+
+namespace terraria::game {
+
+// Order-sensitive hash of simulation state; floats are hashed by bit pattern so any drift shows.
+class StateHasher {
+public:
+    void add(std::uint64_t value) { hash_ = core::SplitMix64(hash_ ^ value); }
+    void add(int value) { add(static_cast<std::uint64_t>(static_cast<std::uint32_t>(value))); }
+    void add(bool value) { add(static_cast<std::uint64_t>(value ? 1 : 0)); }
+    void add(float value) { add(static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(value))); }
+    void add(const entities::Vec2& value) {
+        add(value.x);
+        add(value.y);
+    }
+
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_{0};
+};
+
+} // namespace terraria::game
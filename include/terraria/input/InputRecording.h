@@ -0,0 +1,31 @@
+#pragma once
+
+#include "terraria/input/InputSystem.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace terraria::input {
+
+// Simulation settings a recording was captured under; replaying with anything else diverges.
+struct InputRecordingHeader {
+    std::uint32_t simulationHz{60};
+    std::uint64_t simulationSeed{0};
+    std::int32_t worldWidth{0};
+    std::int32_t worldHeight{0};
+    std::int32_t windowWidth{0};
+    std::int32_t windowHeight{0};
+};
+
+bool ReadInputRecordingHeader(const std::string& path, InputRecordingHeader& header);
+
+// Wraps another input system and appends every polled state to path, one frame per poll. Each frame
+// stores only the fields that changed since the previous one, so idle frames cost two bytes.
+std::unique_ptr<IInputSystem> CreateRecordingInputSystem(std::unique_ptr<IInputSystem> inner,
+                                                         const std::string& path,
+                                                         const InputRecordingHeader& header);
+// Plays a recording back one frame per poll without a window; reports quit once the last frame is out.
+std::unique_ptr<IInputSystem> CreateReplayInputSystem(const std::string& path);
+
+} // namespace terraria::input
@@ -36,6 +36,7 @@ struct InputState {
     bool minimapZoomOut{false};
     bool minimapToggle{false};
     bool minimapDrag{false};
+    bool perfToggle{false};
     int mouseDeltaX{0};
     int mouseDeltaY{0};
     std::string textInput{};
@@ -52,5 +53,7 @@ public:
 };
 
 std::unique_ptr<IInputSystem> CreateSdlInputSystem();
+// Never presses anything and never asks to quit.
+std::unique_ptr<IInputSystem> CreateNullInputSystem();
 
 } // namespace terraria::input
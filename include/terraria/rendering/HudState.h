@@ -1,9 +1,12 @@
 #pragma once
 
+#include "terraria/core/FrameStats.h"
+#include "terraria/core/MemoryTags.h"
 #include "terraria/entities/Tools.h"
 #include "terraria/world/Tile.h"
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -24,6 +27,9 @@ constexpr int kMaxFlyingEnemies = 24;
 constexpr int kMaxEnemyProjectiles = 64;
 constexpr int kMaxWorms = 24;
 
+template <typename T>
+using HudList = core::TrackedVector<T, core::MemoryTag::Hud>;
+
 struct HotbarSlotHud {
     bool isTool{false};
     bool isArmor{false};
@@ -81,6 +87,13 @@ struct EnemyProjectileHudEntry {
     bool isFlame{false};
 };
 
+struct ZombieHudEntry {
+    float x{0.0F};
+    float y{0.0F};
+    int health{0};
+    int maxHealth{0};
+};
+
 struct FlyingEnemyHudEntry {
     bool active{false};
     float x{0.0F};
@@ -165,6 +178,8 @@ struct HudState {
     bool useCamera{false};
     float cameraX{0.0F};
     float cameraY{0.0F};
+    float playerX{0.0F}; // interpolated between the last two simulation steps
+    float playerY{0.0F};
     int playerHealth{0};
     int playerMaxHealth{0};
     int playerDefense{0};
@@ -173,7 +188,7 @@ struct HudState {
     bool isNight{false};
     int craftSelection{0};
     int craftRecipeCount{0};
-    std::vector<CraftHudEntry> craftRecipes{};
+    HudList<CraftHudEntry> craftRecipes{};
     int craftScrollOffset{0};
     int craftVisibleRows{0};
     int craftPanelX{0};
@@ -198,32 +213,44 @@ struct HudState {
     float swordSwingHalfHeight{0.0F};
     int projectileCount{0};
     std::array<ProjectileHudEntry, kMaxProjectiles> projectiles{};
+    HudList<ZombieHudEntry> zombies{}; // only those near the view
     int enemyProjectileCount{0};
     std::array<EnemyProjectileHudEntry, kMaxEnemyProjectiles> enemyProjectiles{};
-    int flyingEnemyCount{0};
+    int flyingEnemyCount{0}; // the first kMaxFlyingEnemies near the view
     std::array<FlyingEnemyHudEntry, kMaxFlyingEnemies> flyingEnemies{};
-    int wormCount{0};
+    int wormCount{0}; // the first kMaxWorms near the view
     std::array<WormHudEntry, kMaxWorms> worms{};
     DragonHudEntry dragon{};
-    std::vector<DamageNumberHud> damageNumbers{};
+    HudList<DamageNumberHud> damageNumbers{};
     int mouseX{0};
     int mouseY{0};
     float perfFrameMs{0.0F};
     float perfUpdateMs{0.0F};
     float perfRenderMs{0.0F};
     float perfFps{0.0F};
+    std::uint64_t perfHeapAllocations{0}; // global operator new calls during the previous frame
+    bool perfExpanded{false};
+    core::TimingSummary perfFrameTiming{};
+    core::TimingSummary perfUpdateTiming{};
+    core::TimingSummary perfRenderTiming{};
+    std::array<std::uint32_t, core::RollingHistogram::kBuckets> perfFrameHistogram{};
+    std::uint32_t perfHitches{0};
+    std::array<core::MemoryTagUsage, core::kMemoryTagCount> perfMemory{};
+    std::uint64_t simulationTick{0};
+    std::uint64_t stateHash{0};
+    bool saving{false};
     bool consoleOpen{false};
     std::string consoleInput{};
     std::string consoleStatus{};
     std::size_t consoleCursor{0};
-    std::vector<ChatLineHud> chatLines{};
+    HudList<ChatLineHud> chatLines{};
     bool menuOpen{false};
     std::string menuTitle{};
-    std::vector<std::string> menuEntries{};
+    HudList<std::string> menuEntries{};
     int menuSelected{0};
     std::string menuHint{};
     std::string menuDetailTitle{};
-    std::vector<std::string> menuDetailLines{};
+    HudList<std::string> menuDetailLines{};
     bool menuEditActive{false};
     std::string menuEditLabel{};
     std::string menuEditValue{};
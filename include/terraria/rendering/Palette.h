@@ -0,0 +1,38 @@
+#pragma once
+
+#include "terraria/world/Tile.h"
+
+#include <cstdint>
+
+namespace terraria::rendering {
+
+struct Rgba {
+    std::uint8_t r{0};
+    std::uint8_t g{0};
+    std::uint8_t b{0};
+    std::uint8_t a{0};
+};
+
+// Shared by the SDL renderer and headless tools so exported maps match the in-game colors.
+constexpr Rgba TileColor(world::TileType type) {
+    switch (type) {
+    case world::TileType::Dirt: return Rgba{126, 86, 59, 255};
+    case world::TileType::Stone: return Rgba{100, 100, 100, 255};
+    case world::TileType::Grass: return Rgba{50, 160, 60, 255};
+    case world::TileType::CopperOre: return Rgba{220, 140, 80, 255};
+    case world::TileType::IronOre: return Rgba{150, 165, 185, 255};
+    case world::TileType::GoldOre: return Rgba{252, 205, 40, 255};
+    case world::TileType::Arrow: return Rgba{230, 230, 230, 255};
+    case world::TileType::Coin: return Rgba{245, 220, 120, 255};
+    case world::TileType::Wood: return Rgba{120, 82, 50, 255};
+    case world::TileType::Leaves: return Rgba{60, 180, 90, 220};
+    case world::TileType::WoodPlank: return Rgba{180, 130, 80, 255};
+    case world::TileType::StoneBrick: return Rgba{150, 125, 125, 255};
+    case world::TileType::TreeTrunk: return Rgba{130, 90, 55, 200};
+    case world::TileType::TreeLeaves: return Rgba{70, 190, 100, 180};
+    case world::TileType::Air:
+    default: return Rgba{0, 0, 0, 0};
+    }
+}
+
+} // namespace terraria::rendering
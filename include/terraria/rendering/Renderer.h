@@ -1,16 +1,14 @@
 #pragma once
 
 #include "terraria/entities/Player.h"
-#include "terraria/entities/Zombie.h"
 #include "terraria/rendering/HudState.h"
 #include "terraria/world/World.h"
 
-#include <vector>
-
 #include <memory>
 
 namespace terraria::core {
 struct AppConfig;
+class FrameArena;
 }
 
 namespace terraria::rendering {
@@ -21,11 +19,13 @@ public:
     virtual void initialize() = 0;
     virtual void render(const world::World& world,
                         const entities::Player& player,
-                        const std::vector<entities::Zombie>& zombies,
-                        const HudState& hud) = 0;
+                        const HudState& hud,
+                        core::FrameArena& frame) = 0; // scratch memory, reset after the frame
     virtual void shutdown() = 0;
 };
 
 std::unique_ptr<IRenderer> CreateSdlRenderer(const core::AppConfig& config);
+// Draws nothing; for headless runs and builds without SDL.
+std::unique_ptr<IRenderer> CreateNullRenderer();
 
 } // namespace terraria::rendering
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace terraria::tools {
+
+// Headless subcommands run as `terra_clone <command> [args...]`.
+int RunCommand(int argc, char** argv);
+
+int RunSaveBenchmark(const std::vector<std::string>& args);
+int RunEnemyBenchmark(const std::vector<std::string>& args);
+int RunWorldDiff(const std::vector<std::string>& args);
+int RunWorldVerify(const std::vector<std::string>& args);
+int RunMapExport(const std::vector<std::string>& args);
+int RunRecordSession(const std::vector<std::string>& args);
+int RunReplaySession(const std::vector<std::string>& args);
+int RunSimulateSession(const std::vector<std::string>& args);
+
+} // namespace terraria::tools
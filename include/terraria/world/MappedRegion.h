@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace terraria::world {
+
+// Copy-on-write view of a byte range of a file. Pages are faulted in on first touch and
+// writes stay private to the process. Falls back to reading into memory where mmap is missing.
+class MappedRegion {
+public:
+    MappedRegion() = default;
+    ~MappedRegion();
+
+    MappedRegion(MappedRegion&& other) noexcept;
+    MappedRegion& operator=(MappedRegion&& other) noexcept;
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+
+    bool open(const std::filesystem::path& path, std::uint64_t offset, std::size_t length);
+    void reset();
+
+    std::uint8_t* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return data_ == nullptr; }
+
+private:
+    void* base_{nullptr};
+    std::size_t baseLength_{0};
+    std::uint8_t* data_{nullptr};
+    std::size_t size_{0};
+    std::vector<std::uint8_t> fallback_{};
+};
+
+} // namespace terraria::world
@@ -30,7 +30,6 @@ public:
 
     TileType type() const { return type_; }
     bool active() const { return active_; }
-    void setActive(bool active) { active_ = active; }
 
     virtual bool isSolid() const = 0;
     virtual TileType dropType() const { return type_; }
@@ -76,6 +75,16 @@ public:
     TileType dropType() const override { return TileType::Leaves; }
 };
 
+constexpr std::uint8_t kTileActiveBit = 0x80;
+constexpr std::uint8_t kTileTypeMask = 0x7F;
+
+inline std::uint8_t PackTile(TileType type, bool active) {
+    return static_cast<std::uint8_t>((static_cast<std::uint8_t>(type) & kTileTypeMask) | (active ? kTileActiveBit : 0));
+}
+
 std::unique_ptr<Tile> MakeTile(TileType type, bool active);
 
+// Shared immutable tile for a packed cell value; worlds store packed bytes, not Tile objects.
+const Tile& SharedTile(std::uint8_t packed);
+
 } // namespace terraria::world
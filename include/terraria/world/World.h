@@ -1,34 +1,76 @@
 #pragma once
 
+#include "terraria/core/MemoryTags.h"
+#include "terraria/world/MappedRegion.h"
 #include "terraria/world/Tile.h"
 
 #include <cstddef>
-#include <memory>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 namespace terraria::world {
 
+// Order-independent 64-bit hash of one chunk's cells: a sum of per-cell mixes keyed by the cell's
+// offset in the chunk, so a single edit updates it in O(1). Not cryptographic.
+std::uint64_t ChunkHash(const std::uint8_t* cells);
+
+// Tiles are stored as packed bytes (see PackTile) in square chunks laid out chunk-major,
+// so a chunk is contiguous and the layout matches the on-disk world body byte for byte.
+// Each chunk's ChunkHash is kept current as tiles change.
 class World {
 public:
+    using EditListener = std::function<void(int x, int y, std::uint8_t cell)>;
+
+    static constexpr int kChunkSize = 64;
+    static constexpr std::size_t kChunkArea = static_cast<std::size_t>(kChunkSize) * kChunkSize;
+
     World(int width, int height);
+    // Hashes stored with the mapped cells are adopted as-is so loading does not touch every page.
+    World(int width, int height, MappedRegion cells, std::vector<std::uint64_t> chunkHashes = {});
 
     int width() const { return width_; }
     int height() const { return height_; }
+    int chunksX() const { return chunksX_; }
+    int chunksY() const { return chunksY_; }
 
-    Tile& tile(int x, int y);
     const Tile& tile(int x, int y) const;
+    std::uint8_t cell(int x, int y) const;
 
     void setTile(int x, int y, TileType type, bool active);
     void setTileType(int x, int y, TileType type);
+    void setChunk(std::size_t chunk, const std::uint8_t* cells);
+    void setEditListener(EditListener listener) { editListener_ = std::move(listener); }
+    // Writes through chunkCells bypass hashing; call rehashChunk afterwards.
+    std::uint8_t* chunkCells(std::size_t chunk);
+    const std::uint8_t* chunkCells(std::size_t chunk) const;
+    void rehashChunk(std::size_t chunk);
+
+    std::uint64_t chunkHash(std::size_t chunk) const { return chunkHashes_[chunk]; }
+    const std::vector<std::uint64_t>& chunkHashes() const { return chunkHashes_; }
+    // Adopts hashes read alongside the cells instead of recomputing them; ignored on size mismatch.
+    void setChunkHashes(std::vector<std::uint64_t> hashes);
+
+    const std::uint8_t* cells() const { return cellData(); }
+    std::size_t cellCount() const { return static_cast<std::size_t>(chunksX_) * static_cast<std::size_t>(chunksY_) * kChunkArea; }
+    bool mapped() const { return !mapping_.empty(); }
+    std::size_t chunkCount() const { return static_cast<std::size_t>(chunksX_) * static_cast<std::size_t>(chunksY_); }
 
-    const std::vector<std::unique_ptr<Tile>>& data() const { return tiles_; }
+    static std::size_t cellCountFor(int width, int height);
 
 private:
     std::size_t index(int x, int y) const;
+    std::uint8_t* cellData();
+    const std::uint8_t* cellData() const;
 
     int width_;
     int height_;
-    std::vector<std::unique_ptr<Tile>> tiles_;
+    int chunksX_;
+    int chunksY_;
+    core::TrackedVector<std::uint8_t, core::MemoryTag::World> cells_;
+    MappedRegion mapping_;
+    std::vector<std::uint64_t> chunkHashes_;
+    EditListener editListener_{};
 };
 
 } // namespace terraria::world
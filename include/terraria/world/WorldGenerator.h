@@ -8,6 +8,9 @@ namespace terraria::world {
 
 class WorldGenerator {
 public:
+    // Bump whenever generate() output changes for the same seed and config; delta saves depend on it.
+    static constexpr std::uint32_t kVersion = 1;
+
     struct WorldGenConfig {
         float terrainAmplitude{1.0F};
         float soilDepthScale{1.0F};
@@ -1,15 +1,15 @@
 #include "terraria/core/Application.h"
 
+#include "terraria/core/FramePacer.h"
 #include "terraria/game/Game.h"
 
-#include <chrono>
-#include <thread>
-
-using namespace std::chrono_literals;
+#include <utility>
 
 namespace terraria::core {
 
 Application::Application() = default;
+Application::Application(AppConfig config)
+    : config_{std::move(config)} {}
 Application::~Application() = default;
 
 void Application::init() {
@@ -26,8 +26,9 @@ void Application::run() {
     game::Game game{config_};
     game.initialize();
 
-    while (running_ && game.tick()) {
-        std::this_thread::sleep_for(16ms); // placeholder frame limiter
+    FramePacer pacer{config_.targetFps, config_.vsync};
+    while (running_ && game.tick(pacer.beginFrame())) {
+        pacer.waitForNextFrame();
     }
 
     game.shutdown();
@@ -0,0 +1,43 @@
+#include "terraria/core/FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace terraria::core {
+
+FrameArena::FrameArena(std::size_t capacity, MemoryTag tag)
+    : tag_{tag},
+      block_{std::make_unique<std::byte[]>(capacity)},
+      capacity_{capacity} {
+    TrackAllocation(tag_, capacity_);
+}
+
+FrameArena::~FrameArena() {
+    TrackDeallocation(tag_, capacity_);
+}
+
+void FrameArena::reset() {
+    peak_ = std::max(peak_, used());
+    if (spilled_ > 0) {
+        spill_.release();
+        TrackDeallocation(tag_, capacity_);
+        capacity_ = std::max(capacity_ * 2, offset_ + spilled_ * 2);
+        block_ = std::make_unique<std::byte[]>(capacity_);
+        TrackAllocation(tag_, capacity_);
+    }
+    offset_ = 0;
+    spilled_ = 0;
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    const auto base = reinterpret_cast<std::uintptr_t>(block_.get());
+    const std::size_t start = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+    if (start + bytes <= capacity_) {
+        offset_ = start + bytes;
+        return block_.get() + start;
+    }
+    spilled_ += bytes;
+    return spill_.allocate(bytes, alignment);
+}
+
+} // namespace terraria::core
@@ -0,0 +1,52 @@
+#include "terraria/core/FramePacer.h"
+
+#include <thread>
+
+namespace terraria::core {
+
+namespace {
+
+// Sleep granularity is typically 1 ms or worse; spin the final stretch.
+constexpr auto kSpinMargin = std::chrono::microseconds(1500);
+constexpr auto kVsyncSlack = std::chrono::microseconds(2000);
+
+} // namespace
+
+FramePacer::FramePacer(int targetFps, bool vsync)
+    : period_{targetFps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps))
+                            : Clock::duration::zero()},
+      vsync_{vsync} {}
+
+float FramePacer::beginFrame() {
+    const auto now = Clock::now();
+    if (!started_) {
+        started_ = true;
+        lastFrame_ = now;
+        deadline_ = now + period_;
+        return std::chrono::duration<float>(period_).count();
+    }
+    const float elapsed = std::chrono::duration<float>(now - lastFrame_).count();
+    lastFrame_ = now;
+    return elapsed;
+}
+
+void FramePacer::waitForNextFrame() {
+    if (period_ == Clock::duration::zero()) {
+        return;
+    }
+    const auto now = Clock::now();
+    if (now >= deadline_ || (vsync_ && deadline_ - now < kVsyncSlack)) {
+        // Late (or vsync already paced us): restart the schedule instead of rushing to catch up.
+        deadline_ = now + period_;
+        return;
+    }
+    if (deadline_ - now > kSpinMargin) {
+        std::this_thread::sleep_for(deadline_ - now - kSpinMargin);
+    }
+    while (Clock::now() < deadline_) {
+        std::this_thread::yield();
+    }
+    deadline_ += period_;
+}
+
+} // namespace terraria::core
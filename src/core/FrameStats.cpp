@@ -0,0 +1,75 @@
+#include "terraria/core/FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace terraria::core {
+
+namespace {
+
+constexpr float kFirstBucketMs = 0.1F;
+constexpr float kBucketsPerDoubling = 6.0F;
+
+} // namespace
+
+RollingHistogram::RollingHistogram(double windowSeconds, std::size_t maxSamples)
+    : window_{windowSeconds},
+      ring_(std::max<std::size_t>(1, maxSamples)) {}
+
+void RollingHistogram::add(double nowSeconds, float ms) {
+    while (size_ > 0 && nowSeconds - ring_[head_].time > window_) {
+        dropOldest();
+    }
+    if (size_ == ring_.size()) {
+        dropOldest();
+    }
+    const std::size_t bucket = bucketFor(ms);
+    ring_[(head_ + size_) % ring_.size()] = {nowSeconds, ms, static_cast<std::uint8_t>(bucket)};
+    ++size_;
+    ++counts_[bucket];
+}
+
+TimingSummary RollingHistogram::summary() const {
+    TimingSummary result{};
+    if (size_ == 0) {
+        return result;
+    }
+    for (std::size_t i = 0; i < size_; ++i) {
+        result.max = std::max(result.max, ring_[(head_ + i) % ring_.size()].ms);
+    }
+    const auto percentile = [&](double fraction) {
+        const auto rank = static_cast<std::uint32_t>(std::ceil(fraction * static_cast<double>(size_)));
+        std::uint32_t seen = 0;
+        for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            seen += counts_[bucket];
+            if (seen >= rank) {
+                return bucket + 1 == kBuckets ? result.max : std::min(bucketUpperMs(bucket), result.max);
+            }
+        }
+        return result.max;
+    };
+    result.p50 = percentile(0.50);
+    result.p95 = percentile(0.95);
+    result.p99 = percentile(0.99);
+    return result;
+}
+
+std::size_t RollingHistogram::bucketFor(float ms) {
+    if (!(ms > kFirstBucketMs)) {
+        return 0;
+    }
+    const float index = std::ceil(std::log2(ms / kFirstBucketMs) * kBucketsPerDoubling);
+    return std::min(kBuckets - 1, static_cast<std::size_t>(index));
+}
+
+float RollingHistogram::bucketUpperMs(std::size_t bucket) {
+    return kFirstBucketMs * std::exp2(static_cast<float>(bucket) / kBucketsPerDoubling);
+}
+
+void RollingHistogram::dropOldest() {
+    --counts_[ring_[head_].bucket];
+    head_ = (head_ + 1) % ring_.size();
+    --size_;
+}
+
+} // namespace terraria::core
@@ -0,0 +1,130 @@
+#include "terraria/core/HeapStats.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace terraria::core {
+
+namespace {
+
+std::atomic<std::uint64_t> gHeapAllocations{0};
+
+void* allocate(std::size_t size) {
+    gHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    gHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment.
+    const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded);
+#endif
+}
+
+void releaseAligned(void* pointer) {
+#ifdef _MSC_VER
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+} // namespace
+
+std::uint64_t HeapAllocationCount() {
+    return gHeapAllocations.load(std::memory_order_relaxed);
+}
+
+} // namespace terraria::core
+
+void* operator new(std::size_t size) {
+    if (void* pointer = terraria::core::allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return terraria::core::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return terraria::core::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = terraria::core::allocateAligned(size, alignment)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return terraria::core::allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return terraria::core::allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    terraria::core::releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    terraria::core::releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    terraria::core::releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    terraria::core::releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    terraria::core::releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    terraria::core::releaseAligned(pointer);
+}
@@ -0,0 +1,272 @@
+#include "terraria/core/JobSystem.h"
+
+#include "terraria/core/Parallel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace terraria::core {
+
+namespace {
+
+// Deque owned by the current thread: the worker's own, or 0 (shared submission) outside the pool.
+thread_local const JobSystem* tlsSystem = nullptr;
+thread_local std::size_t tlsQueue = 0;
+
+constexpr std::size_t kChunksPerThread = 4;
+
+} // namespace
+
+JobSystem::JobSystem(int threadCount) {
+    const std::size_t count = static_cast<std::size_t>(std::max(1, threadCount));
+    queues_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(count - 1);
+    for (std::size_t i = 1; i < count; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+JobSystem& JobSystem::Shared() {
+    static JobSystem shared{DefaultThreadCount()};
+    return shared;
+}
+
+void JobSystem::run(JobFunction fn, JobCounter& counter, const char* name) {
+    counter.pending_.fetch_add(1, std::memory_order_relaxed);
+    Job job{};
+    job.fn = std::move(fn);
+    job.counter = &counter;
+    job.name = name;
+    push(std::move(job));
+}
+
+void JobSystem::runAfter(const JobCounter& dependency, JobFunction fn, JobCounter& counter, const char* name) {
+    counter.pending_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex_);
+        if (!dependency.done()) {
+            dependency.deferred_.push_back({std::move(fn), &counter, name});
+            return;
+        }
+    }
+    Job job{};
+    job.fn = std::move(fn);
+    job.counter = &counter;
+    job.name = name;
+    push(std::move(job));
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    while (!counter.done()) {
+        if (!tryRunOneOf(counter)) {
+            std::this_thread::yield();
+        }
+    }
+    // The last job drops its count while holding the lock; once we hold it, the counter may be destroyed.
+    std::lock_guard<std::mutex> lock(counter.mutex_);
+}
+
+void JobSystem::parallelForRange(std::size_t count, std::size_t grain, RangeTask task, const char* name) {
+    if (count == 0) {
+        return;
+    }
+    const std::size_t maxChunks = static_cast<std::size_t>(threadCount()) * kChunksPerThread;
+    const std::size_t chunks = std::clamp(count / std::max<std::size_t>(1, grain), std::size_t{1}, maxChunks);
+    if (chunks == 1) {
+        task.invoke(task.context, 0, count);
+        return;
+    }
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+    JobCounter counter;
+    for (std::size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        Job job{};
+        job.range = task;
+        job.begin = begin;
+        job.end = std::min(count, begin + chunkSize);
+        job.counter = &counter;
+        job.name = name;
+        counter.pending_.fetch_add(1, std::memory_order_relaxed);
+        push(std::move(job));
+    }
+    task.invoke(task.context, 0, std::min(count, chunkSize));
+    wait(counter);
+}
+
+void JobSystem::push(Job job) {
+    if (workers_.empty()) {
+        execute(job);
+        return;
+    }
+    const std::size_t queue = tlsSystem == this ? tlsQueue : 0;
+    {
+        std::lock_guard<std::mutex> lock(queues_[queue]->mutex);
+        queues_[queue]->pushBack(std::move(job));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+    {
+        // Taking the lock orders this wake-up after any worker that just found nothing is asleep.
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+bool JobSystem::tryRunOne() {
+    const std::size_t self = tlsSystem == this ? tlsQueue : 0;
+    Job job;
+    if (pop(self, job) || steal(self, job)) {
+        execute(job);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::tryRunOneOf(const JobCounter& counter) {
+    const std::size_t self = tlsSystem == this ? tlsQueue : 0;
+    const std::size_t count = queues_.size();
+    Job job;
+    for (std::size_t offset = 0; offset < count; ++offset) {
+        Queue& queue = *queues_[(self + offset) % count];
+        bool found = false;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            found = queue.take(counter, job);
+        }
+        if (found) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            execute(job);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::pop(std::size_t queue, Job& job) {
+    Queue& own = *queues_[queue];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.size == 0) {
+        return false;
+    }
+    own.popBack(job);
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(std::size_t thief, Job& job) {
+    const std::size_t count = queues_.size();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        Queue& victim = *queues_[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.size == 0) {
+            continue;
+        }
+        victim.popFront(job);
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(Job& job) {
+    const JobTraceHooks hooks = hooks_;
+    if (hooks.begin != nullptr) {
+        hooks.begin(job.name);
+    }
+    if (job.range.invoke != nullptr) {
+        job.range.invoke(job.range.context, job.begin, job.end);
+    } else {
+        job.fn();
+    }
+    if (hooks.end != nullptr) {
+        hooks.end(job.name);
+    }
+    finish(*job.counter);
+}
+
+void JobSystem::finish(JobCounter& counter) {
+    std::vector<JobCounter::Deferred> ready;
+    {
+        // Under the lock so runAfter either sees the counter done or parks its job where we collect it.
+        std::lock_guard<std::mutex> lock(counter.mutex_);
+        if (counter.pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        ready.swap(counter.deferred_);
+    }
+    for (auto& deferred : ready) {
+        Job job{};
+        job.fn = std::move(deferred.fn);
+        job.counter = deferred.counter;
+        job.name = deferred.name;
+        push(std::move(job));
+    }
+}
+
+void JobSystem::Queue::pushBack(Job job) {
+    if (size == ring.size()) {
+        std::vector<Job> grown(std::max<std::size_t>(16, ring.size() * 2));
+        for (std::size_t i = 0; i < size; ++i) {
+            grown[i] = std::move(ring[(head + i) % ring.size()]);
+        }
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + size) % ring.size()] = std::move(job);
+    ++size;
+}
+
+void JobSystem::Queue::popBack(Job& job) {
+    --size;
+    job = std::move(ring[(head + size) % ring.size()]);
+}
+
+void JobSystem::Queue::popFront(Job& job) {
+    job = std::move(ring[head]);
+    head = (head + 1) % ring.size();
+    --size;
+}
+
+bool JobSystem::Queue::take(const JobCounter& counter, Job& job) {
+    for (std::size_t i = size; i-- > 0;) {
+        if (ring[(head + i) % ring.size()].counter != &counter) {
+            continue;
+        }
+        job = std::move(ring[(head + i) % ring.size()]);
+        for (std::size_t j = i + 1; j < size; ++j) {
+            ring[(head + j - 1) % ring.size()] = std::move(ring[(head + j) % ring.size()]);
+        }
+        --size;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(std::size_t queue) {
+    tlsSystem = this;
+    tlsQueue = queue;
+    while (true) {
+        if (tryRunOne()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this]() { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stopping_) {
+            return;
+        }
+    }
+}
+
+} // namespace terraria::core
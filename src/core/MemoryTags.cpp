@@ -0,0 +1,27 @@
+#include "terraria/core/MemoryTags.h"
+
+namespace terraria::core {
+
+namespace detail {
+std::array<MemoryTagCounters, kMemoryTagCount> memoryTagCounters{};
+} // namespace detail
+
+const char* MemoryTagName(MemoryTag tag) {
+    switch (tag) {
+    case MemoryTag::World: return "world";
+    case MemoryTag::ExploredMaps: return "explored maps";
+    case MemoryTag::Enemies: return "enemies";
+    case MemoryTag::SaveBuffers: return "save buffers";
+    case MemoryTag::Textures: return "textures";
+    case MemoryTag::Hud: return "hud";
+    case MemoryTag::Count: break;
+    }
+    return "unknown";
+}
+
+MemoryTagUsage MemoryUsage(MemoryTag tag) {
+    const auto& counters = detail::memoryTagCounters[static_cast<std::size_t>(tag)];
+    return {counters.live.load(std::memory_order_relaxed), counters.peak.load(std::memory_order_relaxed)};
+}
+
+} // namespace terraria::core
@@ -0,0 +1,41 @@
+#include "terraria/core/Parallel.h"
+
+#include "terraria/core/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace terraria::core {
+
+int DefaultThreadCount() {
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : static_cast<int>(hardware);
+}
+
+void ParallelFor(std::size_t count, int threadCount, const std::function<void(std::size_t)>& fn) {
+    JobSystem& jobs = JobSystem::Shared();
+    const std::size_t workers = std::min({count,
+                                          static_cast<std::size_t>(std::max(1, threadCount)),
+                                          static_cast<std::size_t>(jobs.threadCount())});
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    std::atomic<std::size_t> next{0};
+    const auto drain = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    JobCounter counter;
+    for (std::size_t t = 1; t < workers; ++t) {
+        jobs.run(drain, counter, "ParallelFor");
+    }
+    drain();
+    jobs.wait(counter);
+}
+
+} // namespace terraria::core
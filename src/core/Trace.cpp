@@ -0,0 +1,219 @@
+#include "terraria/core/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace terraria::core {
+
+namespace detail {
+std::atomic<bool> traceCapturing{false};
+} // namespace detail
+
+namespace {
+
+constexpr std::size_t kEventsPerThread = std::size_t{1} << 16;
+
+enum class EventKind : std::uint8_t { Begin, End, Counter, Marker };
+
+struct Event {
+    const char* name{nullptr};
+    std::int64_t ns{0};
+    double value{0.0};
+    EventKind kind{EventKind::Begin};
+};
+
+struct ThreadBuffer {
+    std::mutex mutex{};
+    std::vector<Event> ring{};
+    std::size_t next{0};
+    std::size_t count{0};
+    std::size_t id{0};
+    const char* name{nullptr};
+};
+
+// Buffers are never freed, so a thread that exits mid-capture still shows up in the export.
+struct Registry {
+    std::mutex mutex{};
+    std::vector<std::unique_ptr<ThreadBuffer>> threads{};
+    std::int64_t startNs{0};
+    int framesLeft{0};
+    std::string path{};
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+thread_local ThreadBuffer* tlsBuffer = nullptr;
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+ThreadBuffer& threadBuffer() {
+    if (tlsBuffer == nullptr) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.threads.push_back(std::make_unique<ThreadBuffer>());
+        tlsBuffer = reg.threads.back().get();
+        tlsBuffer->id = reg.threads.size();
+    }
+    return *tlsBuffer;
+}
+
+void record(const char* name, EventKind kind, double value) {
+    const std::int64_t ns = nowNs();
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.ring.empty()) {
+        buffer.ring.resize(kEventsPerThread);
+    }
+    buffer.ring[buffer.next] = {name, ns, value, kind};
+    buffer.next = (buffer.next + 1) % buffer.ring.size();
+    buffer.count = std::min(buffer.count + 1, buffer.ring.size());
+}
+
+bool writeTrace(const Registry& reg) {
+    std::FILE* file = std::fopen(reg.path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    const auto separator = [&]() {
+        if (!first) {
+            std::fprintf(file, ",\n");
+        }
+        first = false;
+    };
+    for (const auto& thread : reg.threads) {
+        std::lock_guard<std::mutex> lock(thread->mutex);
+        const auto tid = static_cast<unsigned long long>(thread->id);
+        separator();
+        if (thread->name != nullptr) {
+            std::fprintf(file,
+                         R"({"name":"thread_name","ph":"M","pid":1,"tid":%llu,"args":{"name":"%s"}})",
+                         tid,
+                         thread->name);
+        } else {
+            std::fprintf(file,
+                         R"({"name":"thread_name","ph":"M","pid":1,"tid":%llu,"args":{"name":"thread %llu"}})",
+                         tid,
+                         tid);
+        }
+        const std::size_t size = thread->ring.size();
+        for (std::size_t i = 0; i < thread->count; ++i) {
+            const Event& event = thread->ring[(thread->next + size - thread->count + i) % size];
+            if (event.ns < reg.startNs) {
+                continue;
+            }
+            const double us = static_cast<double>(event.ns - reg.startNs) / 1000.0;
+            separator();
+            switch (event.kind) {
+            case EventKind::Begin:
+            case EventKind::End:
+                std::fprintf(file,
+                             R"({"name":"%s","ph":"%c","ts":%.3f,"pid":1,"tid":%llu})",
+                             event.name,
+                             event.kind == EventKind::Begin ? 'B' : 'E',
+                             us,
+                             tid);
+                break;
+            case EventKind::Counter:
+                std::fprintf(file,
+                             R"({"name":"%s","ph":"C","ts":%.3f,"pid":1,"tid":%llu,"args":{"value":%g}})",
+                             event.name,
+                             us,
+                             tid,
+                             event.value);
+                break;
+            case EventKind::Marker:
+                std::fprintf(file,
+                             R"({"name":"%s","ph":"i","s":"p","ts":%.3f,"pid":1,"tid":%llu})",
+                             event.name,
+                             us,
+                             tid);
+                break;
+            }
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+bool StartTraceCapture(int frames, std::string path) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (detail::traceCapturing.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    for (auto& thread : reg.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        thread->next = 0;
+        thread->count = 0;
+    }
+    reg.framesLeft = std::max(1, frames);
+    reg.path = std::move(path);
+    reg.startNs = nowNs();
+    detail::traceCapturing.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool EndTraceFrame(std::string& outPath, bool& outWritten) {
+    if (!TraceCapturing()) {
+        return false;
+    }
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (--reg.framesLeft > 0) {
+        return false;
+    }
+    detail::traceCapturing.store(false, std::memory_order_relaxed);
+    outPath = reg.path;
+    outWritten = writeTrace(reg);
+    return true;
+}
+
+bool TraceBegin(const char* name) {
+    if (!TraceCapturing()) {
+        return false;
+    }
+    record(name, EventKind::Begin, 0.0);
+    return true;
+}
+
+void TraceEnd(const char* name) {
+    if (TraceCapturing()) {
+        record(name, EventKind::End, 0.0);
+    }
+}
+
+void TraceCounter(const char* name, double value) {
+    if (TraceCapturing()) {
+        record(name, EventKind::Counter, value);
+    }
+}
+
+void TraceMarker(const char* name) {
+    if (TraceCapturing()) {
+        record(name, EventKind::Marker, 0.0);
+    }
+}
+
+void SetTraceThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+} // namespace terraria::core
@@ -0,0 +1,121 @@
+#include "terraria/game/AutosaveService.h"
+
+#include "terraria/core/Trace.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace terraria::game {
+
+AutosaveService::AutosaveService(const SaveManager& saveManager, float intervalSeconds)
+    : saveManager_(saveManager),
+      interval_(intervalSeconds) {
+    worker_ = std::thread([this]() { workerLoop(); });
+}
+
+AutosaveService::~AutosaveService() {
+    shutdown();
+}
+
+void AutosaveService::submit(WorldSnapshot world, CharacterSnapshot character, std::uint64_t tag) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        pending_ = Job{std::move(world), std::move(character), tag};
+        saving_.store(true, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+    timer_ = 0.0F;
+}
+
+bool AutosaveService::tick(float dt) {
+    if (interval_ <= 0.0F) {
+        return false;
+    }
+    timer_ += dt;
+    if (timer_ < interval_) {
+        return false;
+    }
+    timer_ = 0.0F;
+    return true;
+}
+
+void AutosaveService::resetTimer() {
+    timer_ = 0.0F;
+}
+
+bool AutosaveService::saving() const {
+    return saving_.load(std::memory_order_relaxed);
+}
+
+bool AutosaveService::pollCompleted(bool& ok, std::uint64_t& savedTag) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (completed_ == 0) {
+        return false;
+    }
+    completed_ = 0;
+    ok = lastOk_;
+    lastOk_ = true;
+    savedTag = savedTag_;
+    return true;
+}
+
+void AutosaveService::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return !pending_ && !busy_; });
+}
+
+void AutosaveService::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void AutosaveService::workerLoop() {
+    core::SetTraceThreadName("autosave");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this]() { return stopping_ || pending_.has_value(); });
+        if (!pending_) {
+            break;
+        }
+        Job job = std::move(*pending_);
+        pending_.reset();
+        busy_ = true;
+        lock.unlock();
+
+        bool ok = true;
+        if (!job.world.id.empty()) {
+            ok = saveManager_.saveWorld(job.world) && ok;
+        }
+        if (!job.character.id.empty()) {
+            ok = saveManager_.saveCharacter(job.character.id, job.character.name, job.character.player) && ok;
+        }
+
+        lock.lock();
+        busy_ = false;
+        ++completed_;
+        lastOk_ = lastOk_ && ok;
+        if (ok) {
+            savedTag_ = std::max(savedTag_, job.tag);
+        }
+        if (!pending_) {
+            saving_.store(false, std::memory_order_relaxed);
+            idle_.notify_all();
+        }
+    }
+    saving_.store(false, std::memory_order_relaxed);
+    idle_.notify_all();
+}
+
+} // namespace terraria::game
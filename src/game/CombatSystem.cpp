@@ -21,9 +21,9 @@ CombatSystem::CombatSystem(world::World& world,
                            entities::Player& player,
                            PhysicsSystem& physics,
                            DamageNumberSystem& damageNumbers,
-                           std::vector<entities::Zombie>& zombies,
-                           std::vector<entities::FlyingEnemy>& flyers,
-                           std::vector<entities::Worm>& worms,
+                           ZombiePool& zombies,
+                           FlyerPool& flyers,
+                           WormPool& worms,
                            entities::Dragon* dragon,
                            EnemyManager& enemyManager)
     : world_{world},
@@ -65,8 +65,8 @@ void CombatSystem::startSwordSwing(float angleStart, float angleEnd, entities::T
     swordSwing_.damage = swordDamageForTier(swordTier);
     swordSwing_.angleStart = angleStart;
     swordSwing_.angleEnd = angleEnd;
-    swordSwingHitIds_.clear();
-    swordSwingHitFlyerIds_.clear();
+    swordSwingHitZombies_.clear();
+    swordSwingHitFlyers_.clear();
     swordSwingHitDragon_ = false;
     updateSwordSwing(0.0F);
 }
@@ -85,20 +85,49 @@ void CombatSystem::spawnProjectile(const entities::Vec2& direction,
     const int baseDamage = rangedDamageForTier(tier);
     projectile.damage = std::max(1, static_cast<int>(std::round(static_cast<float>(baseDamage) * damageScale)));
     projectile.gravityScale = std::clamp(gravityScale, 0.1F, 2.0F);
+    projectile.previousPosition = projectile.position;
     projectiles_.push_back(projectile);
 }
 
 void CombatSystem::reset() {
     swordSwing_ = {};
-    swordSwingHitIds_.clear();
-    swordSwingHitFlyerIds_.clear();
+    swordSwingHitZombies_.clear();
+    swordSwingHitFlyers_.clear();
     swordSwingHitDragon_ = false;
     projectiles_.clear();
 }
 
-void CombatSystem::update(float dt) {
+void CombatSystem::hashState(StateHasher& hasher) const {
+    hasher.add(swordSwing_.active);
+    hasher.add(swordSwing_.timer);
+    hasher.add(static_cast<std::uint64_t>(projectiles_.size()));
+    for (const auto& projectile : projectiles_) {
+        hasher.add(projectile.position);
+        hasher.add(projectile.velocity);
+        hasher.add(projectile.lifetime);
+        hasher.add(projectile.damage);
+    }
+}
+
+void CombatSystem::update(float dt, BodyStore& bodies) {
+    for (auto& projectile : projectiles_) {
+        projectile.body = kNoBody;
+        projectile.lifetime -= dt;
+        if (projectile.lifetime <= 0.0F) {
+            continue;
+        }
+        projectile.body = bodies.add(projectile.position,
+                                     projectile.velocity,
+                                     0.0F,
+                                     0.0F,
+                                     kProjectileGravity * projectile.gravityScale,
+                                     kBodyPoint);
+    }
+}
+
+void CombatSystem::resolve(float dt, const BodyStore& bodies) {
     updateSwordSwing(dt);
-    updateProjectiles(dt);
+    resolveProjectiles(bodies);
 }
 
 void CombatSystem::updateSwordSwing(float dt) {
@@ -110,66 +139,52 @@ void CombatSystem::updateSwordSwing(float dt) {
     const float angle = swordSwing_.angleStart + (swordSwing_.angleEnd - swordSwing_.angleStart) * progress;
     const entities::Vec2 pivot{player_.position().x, player_.position().y - entities::kPlayerHeight * 0.4F};
     swordSwing_.center = {pivot.x + std::cos(angle) * swordSwing_.radius, pivot.y + std::sin(angle) * swordSwing_.radius};
-    for (auto& zombie : zombies_) {
-        if (!zombie.alive()) {
-            continue;
-        }
-        if (std::find(swordSwingHitIds_.begin(), swordSwingHitIds_.end(), zombie.id) != swordSwingHitIds_.end()) {
-            continue;
-        }
-        if (physics_.aabbOverlap(swordSwing_.center,
-                                 swordSwing_.halfWidth,
-                                 swordSwing_.halfHeight * 2.0F,
-                                 zombie.position,
-                                 entities::kZombieHalfWidth,
-                                 entities::kZombieHeight)) {
-            const float knockDir = (zombie.position.x < swordSwing_.center.x) ? -1.0F : 1.0F;
-            damageZombie(zombie, swordSwing_.damage, knockDir);
-            swordSwingHitIds_.push_back(zombie.id);
-        }
-    }
-    for (auto& flyer : flyers_) {
-        if (!flyer.alive()) {
-            continue;
-        }
-        if (std::find(swordSwingHitFlyerIds_.begin(), swordSwingHitFlyerIds_.end(), flyer.id) != swordSwingHitFlyerIds_.end()) {
-            continue;
-        }
-        if (physics_.aabbOverlap(swordSwing_.center,
-                                 swordSwing_.halfWidth,
-                                 swordSwing_.halfHeight * 2.0F,
-                                 flyer.position,
-                                 entities::kFlyingEnemyRadius,
-                                 entities::kFlyingEnemyRadius * 2.0F)) {
-            const float knockDir = (flyer.position.x < swordSwing_.center.x) ? -1.0F : 1.0F;
-            damageFlyer(flyer, swordSwing_.damage, knockDir);
-            swordSwingHitFlyerIds_.push_back(flyer.id);
+    const SpatialHash& colliders = enemyManager_.colliders();
+    colliders.queryBox(swordSwing_.center, swordSwing_.halfWidth, swordSwing_.halfHeight * 2.0F, kEnemyColliders, hits_);
+    for (const int id : hits_) {
+        const Collider& collider = colliders.collider(id);
+        const auto index = static_cast<std::size_t>(collider.index);
+        switch (collider.kind) {
+        case ColliderKind::Zombie: {
+            const EnemyHandle handle = zombies_.handle(index);
+            if (!zombies_.alive(index)
+                || std::find(swordSwingHitZombies_.begin(), swordSwingHitZombies_.end(), handle)
+                    != swordSwingHitZombies_.end()) {
+                break;
+            }
+            const float knockDir = (zombies_.position[index].x < swordSwing_.center.x) ? -1.0F : 1.0F;
+            damageZombie(index, swordSwing_.damage, knockDir);
+            swordSwingHitZombies_.push_back(handle);
+            break;
         }
-    }
-    for (auto& worm : worms_) {
-        if (!worm.alive()) {
-            continue;
+        case ColliderKind::Flyer: {
+            const EnemyHandle handle = flyers_.handle(index);
+            if (!flyers_.alive(index)
+                || std::find(swordSwingHitFlyers_.begin(), swordSwingHitFlyers_.end(), handle)
+                    != swordSwingHitFlyers_.end()) {
+                break;
+            }
+            const float knockDir = (flyers_.position[index].x < swordSwing_.center.x) ? -1.0F : 1.0F;
+            damageFlyer(index, swordSwing_.damage, knockDir);
+            swordSwingHitFlyers_.push_back(handle);
+            break;
         }
-        if (physics_.aabbOverlap(swordSwing_.center,
-                                 swordSwing_.halfWidth,
-                                 swordSwing_.halfHeight * 2.0F,
-                                 worm.position,
-                                 entities::kWormRadius,
-                                 entities::kWormRadius * 2.0F)) {
-            const float knockDir = (worm.position.x < swordSwing_.center.x) ? -1.0F : 1.0F;
-            damageWorm(worm, swordSwing_.damage, knockDir);
+        case ColliderKind::Worm: {
+            if (worms_.alive(index)) {
+                const float knockDir = (worms_.position[index].x < swordSwing_.center.x) ? -1.0F : 1.0F;
+                damageWorm(index, swordSwing_.damage, knockDir);
+            }
+            break;
         }
-    }
-    if (dragon_ && dragon_->alive() && !swordSwingHitDragon_) {
-        if (physics_.aabbOverlap(swordSwing_.center,
-                                 swordSwing_.halfWidth,
-                                 swordSwing_.halfHeight * 2.0F,
-                                 dragon_->position,
-                                 entities::kDragonHalfWidth,
-                                 entities::kDragonHeight)) {
-            const float knockDir = (dragon_->position.x < swordSwing_.center.x) ? -1.0F : 1.0F;
-            damageDragon(*dragon_, swordSwing_.damage, knockDir);
-            swordSwingHitDragon_ = true;
+        case ColliderKind::Dragon:
+            if (dragon_ && dragon_->alive() && !swordSwingHitDragon_) {
+                const float knockDir = (dragon_->position.x < swordSwing_.center.x) ? -1.0F : 1.0F;
+                damageDragon(*dragon_, swordSwing_.damage, knockDir);
+                swordSwingHitDragon_ = true;
+            }
+            break;
+        case ColliderKind::EnemyProjectile:
+            break;
         }
     }
     enemyManager_.removeEnemyProjectilesInBox(swordSwing_.center, swordSwing_.halfWidth, swordSwing_.halfHeight * 2.0F);
@@ -178,94 +193,36 @@ void CombatSystem::updateSwordSwing(float dt) {
     }
 }
 
-void CombatSystem::updateProjectiles(float dt) {
+void CombatSystem::resolveProjectiles(const BodyStore& bodies) {
     for (auto& projectile : projectiles_) {
-        projectile.lifetime -= dt;
-        if (projectile.lifetime <= 0.0F) {
-            continue;
-        }
-        projectile.velocity.y += kProjectileGravity * projectile.gravityScale * dt;
-        projectile.position.x += projectile.velocity.x * dt;
-        projectile.position.y += projectile.velocity.y * dt;
-        if (projectile.position.x < 0.0F || projectile.position.y < 0.0F
-            || projectile.position.x >= static_cast<float>(world_.width())
-            || projectile.position.y >= static_cast<float>(world_.height())
-            || physics_.solidAtPosition(projectile.position)) {
-            projectile.lifetime = 0.0F;
-            continue;
-        }
-        if (enemyManager_.removeEnemyProjectileAt(projectile.position, projectile.radius)) {
-            projectile.lifetime = 0.0F;
-            continue;
-        }
-        for (auto& zombie : zombies_) {
-            if (!zombie.alive()) {
-                continue;
-            }
-            if (physics_.aabbOverlap(projectile.position,
-                                     projectile.radius,
-                                     projectile.radius * 2.0F,
-                                     zombie.position,
-                                     entities::kZombieHalfWidth,
-                                     entities::kZombieHeight)) {
-                const float knockDir = (projectile.velocity.x < 0.0F) ? -1.0F : 1.0F;
-                damageZombie(zombie, projectile.damage, knockDir);
-                projectile.lifetime = 0.0F;
-                break;
-            }
-        }
-        if (projectile.lifetime <= 0.0F) {
+        if (projectile.body == kNoBody || projectile.lifetime <= 0.0F) {
             continue;
         }
-        for (auto& flyer : flyers_) {
-            if (!flyer.alive()) {
-                continue;
-            }
-            if (physics_.aabbOverlap(projectile.position,
-                                     projectile.radius,
-                                     projectile.radius * 2.0F,
-                                     flyer.position,
-                                     entities::kFlyingEnemyRadius,
-                                     entities::kFlyingEnemyRadius * 2.0F)) {
-                const float knockDir = (projectile.velocity.x < 0.0F) ? -1.0F : 1.0F;
-                damageFlyer(flyer, projectile.damage, knockDir);
-                projectile.lifetime = 0.0F;
-                break;
-            }
-        }
-        if (projectile.lifetime <= 0.0F) {
-            continue;
-        }
-        for (auto& worm : worms_) {
-            if (!worm.alive()) {
-                continue;
-            }
-            if (physics_.aabbOverlap(projectile.position,
-                                     projectile.radius,
-                                     projectile.radius * 2.0F,
-                                     worm.position,
-                                     entities::kWormRadius,
-                                     entities::kWormRadius * 2.0F)) {
-                const float knockDir = (projectile.velocity.x < 0.0F) ? -1.0F : 1.0F;
-                damageWorm(worm, projectile.damage, knockDir);
+        // The body already stopped at any wall; one swept query finds the first thing it struck on the way.
+        const entities::Vec2 start = projectile.position;
+        const entities::Vec2 end = bodies.position(projectile.body);
+        projectile.velocity = bodies.velocity(projectile.body);
+        projectile.position = end;
+        enemyManager_.colliders().querySegment(start,
+                                               end,
+                                               projectile.radius,
+                                               projectile.radius * 2.0F,
+                                               kEnemyColliders | ColliderBit(ColliderKind::EnemyProjectile),
+                                               segmentHits_);
+        for (const SegmentHit& hit : segmentHits_) {
+            if (strikeTarget(projectile, enemyManager_.colliders().collider(hit.collider))) {
+                projectile.position = {start.x + (end.x - start.x) * hit.time, start.y + (end.y - start.y) * hit.time};
                 projectile.lifetime = 0.0F;
                 break;
             }
         }
-        if (projectile.lifetime <= 0.0F) {
-            continue;
+        if (projectile.position.x < 0.0F || projectile.position.y < 0.0F
+            || projectile.position.x >= static_cast<float>(world_.width())
+            || projectile.position.y >= static_cast<float>(world_.height())) {
+            projectile.lifetime = 0.0F;
         }
-        if (dragon_ && dragon_->alive()) {
-            if (physics_.aabbOverlap(projectile.position,
-                                     projectile.radius,
-                                     projectile.radius * 2.0F,
-                                     dragon_->position,
-                                     entities::kDragonHalfWidth,
-                                     entities::kDragonHeight)) {
-                const float knockDir = (projectile.velocity.x < 0.0F) ? -1.0F : 1.0F;
-                damageDragon(*dragon_, projectile.damage, knockDir);
-                projectile.lifetime = 0.0F;
-            }
+        if (bodies.has(projectile.body, kBodyHitWall)) {
+            projectile.lifetime = 0.0F;
         }
     }
     projectiles_.erase(std::remove_if(projectiles_.begin(),
@@ -274,26 +231,60 @@ void CombatSystem::updateProjectiles(float dt) {
                        projectiles_.end());
 }
 
-void CombatSystem::damageZombie(entities::Zombie& zombie, int amount, float knockbackDir) {
-    zombie.health = std::max(0, zombie.health - amount);
-    damageNumbers_.addDamage(zombie.position, amount, false);
-    zombie.knockbackTimer = 0.18F;
-    zombie.knockbackVelocity = knockbackDir * 8.0F;
-    zombie.velocity.y = std::min(zombie.velocity.y, -6.0F);
+bool CombatSystem::strikeTarget(const Projectile& projectile, const Collider& collider) {
+    const auto index = static_cast<std::size_t>(collider.index);
+    const float knockDir = (projectile.velocity.x < 0.0F) ? -1.0F : 1.0F;
+    switch (collider.kind) {
+    case ColliderKind::EnemyProjectile:
+        return enemyManager_.removeEnemyProjectile(collider.index);
+    case ColliderKind::Zombie:
+        if (!zombies_.alive(index)) {
+            return false;
+        }
+        damageZombie(index, projectile.damage, knockDir);
+        return true;
+    case ColliderKind::Flyer:
+        if (!flyers_.alive(index)) {
+            return false;
+        }
+        damageFlyer(index, projectile.damage, knockDir);
+        return true;
+    case ColliderKind::Worm:
+        if (!worms_.alive(index)) {
+            return false;
+        }
+        damageWorm(index, projectile.damage, knockDir);
+        return true;
+    case ColliderKind::Dragon:
+        if (!dragon_ || !dragon_->alive()) {
+            return false;
+        }
+        damageDragon(*dragon_, projectile.damage, knockDir);
+        return true;
+    }
+    return false;
+}
+
+void CombatSystem::damageZombie(std::size_t index, int amount, float knockbackDir) {
+    zombies_.health[index] = std::max(0, zombies_.health[index] - amount);
+    damageNumbers_.addDamage(zombies_.position[index], amount, false);
+    zombies_.state[index].knockbackTimer = 0.18F;
+    zombies_.state[index].knockbackVelocity = knockbackDir * 8.0F;
+    zombies_.velocity[index].y = std::min(zombies_.velocity[index].y, -6.0F);
 }
 
-void CombatSystem::damageFlyer(entities::FlyingEnemy& flyer, int amount, float knockbackDir) {
-    flyer.takeDamage(amount);
-    flyer.knockbackTimer = 0.18F;
-    flyer.knockbackVelocity = knockbackDir * 6.5F;
-    damageNumbers_.addDamage(flyer.position, amount, false);
+void CombatSystem::damageFlyer(std::size_t index, int amount, float knockbackDir) {
+    flyers_.health[index] = std::max(0, flyers_.health[index] - amount);
+    flyers_.state[index].knockbackTimer = 0.18F;
+    flyers_.state[index].knockbackVelocity = knockbackDir * 6.5F;
+    damageNumbers_.addDamage(flyers_.position[index], amount, false);
 }
 
-void CombatSystem::damageWorm(entities::Worm& worm, int amount, float knockbackDir) {
-    worm.takeDamage(amount);
-    worm.knockbackTimer = 0.2F;
-    worm.knockbackVelocity = knockbackDir * 7.5F;
-    damageNumbers_.addDamage(worm.position, amount, false);
+void CombatSystem::damageWorm(std::size_t index, int amount, float knockbackDir) {
+    worms_.health[index] = std::max(0, worms_.health[index] - amount);
+    worms_.state[index].knockbackTimer = 0.2F;
+    worms_.state[index].knockbackVelocity = knockbackDir * 7.5F;
+    damageNumbers_.addDamage(worms_.position[index], amount, false);
 }
 
 void CombatSystem::damageDragon(entities::Dragon& dragon, int amount, float knockbackDir) {
@@ -303,7 +294,13 @@ void CombatSystem::damageDragon(entities::Dragon& dragon, int amount, float knoc
     damageNumbers_.addDamage(dragon.position, amount, false);
 }
 
-void CombatSystem::fillHud(rendering::HudState& hud) const {
+void CombatSystem::storePreviousPositions() {
+    for (auto& projectile : projectiles_) {
+        projectile.previousPosition = projectile.position;
+    }
+}
+
+void CombatSystem::fillHud(rendering::HudState& hud, float alpha) const {
     hud.swordSwingActive = swordSwing_.active;
     if (swordSwing_.active) {
         hud.swordSwingX = swordSwing_.center.x;
@@ -323,9 +320,10 @@ void CombatSystem::fillHud(rendering::HudState& hud) const {
     for (int i = 0; i < projectileCount; ++i) {
         const auto& projectile = projectiles_[static_cast<std::size_t>(i)];
         auto& entry = hud.projectiles[static_cast<std::size_t>(i)];
+        const entities::Vec2 position = entities::Interpolate(projectile.previousPosition, projectile.position, alpha);
         entry.active = true;
-        entry.x = projectile.position.x;
-        entry.y = projectile.position.y;
+        entry.x = position.x;
+        entry.y = position.y;
         entry.radius = projectile.radius;
     }
     for (int i = projectileCount; i < rendering::kMaxProjectiles; ++i) {
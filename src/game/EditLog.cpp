@@ -0,0 +1,329 @@
+#include "terraria/game/EditLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace terraria::game {
+
+namespace {
+
+constexpr std::uint8_t kTileRecord = 1;
+constexpr std::uint8_t kPlayerRecord = 2;
+constexpr std::size_t kSlotBytes = 8;
+constexpr std::size_t kTileRecordBytes = 1 + sizeof(std::int32_t) * 2 + 1;
+constexpr std::size_t kPlayerRecordBytes = 1 + sizeof(std::int32_t)
+    + (static_cast<std::size_t>(entities::kInventorySlots) + 1) * kSlotBytes;
+
+template <typename T>
+void put(std::vector<std::uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T take(const std::uint8_t*& cursor) {
+    T value{};
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+void putSlot(std::vector<std::uint8_t>& out, const entities::InventorySlot& slot) {
+    put(out, static_cast<std::uint8_t>(slot.category));
+    put(out, static_cast<std::uint8_t>(slot.blockType));
+    put(out, static_cast<std::uint8_t>(slot.toolKind));
+    put(out, static_cast<std::uint8_t>(slot.toolTier));
+    put(out, static_cast<std::uint8_t>(slot.armorId));
+    put(out, static_cast<std::uint8_t>(slot.accessoryId));
+    put(out, static_cast<std::uint16_t>(std::clamp(slot.count, 0, 0xFFFF)));
+}
+
+entities::InventorySlot takeSlot(const std::uint8_t*& cursor) {
+    entities::InventorySlot slot{};
+    slot.category = static_cast<entities::ItemCategory>(take<std::uint8_t>(cursor));
+    slot.blockType = static_cast<world::TileType>(take<std::uint8_t>(cursor));
+    slot.toolKind = static_cast<entities::ToolKind>(take<std::uint8_t>(cursor));
+    slot.toolTier = static_cast<entities::ToolTier>(take<std::uint8_t>(cursor));
+    slot.armorId = static_cast<entities::ArmorId>(take<std::uint8_t>(cursor));
+    slot.accessoryId = static_cast<entities::AccessoryId>(take<std::uint8_t>(cursor));
+    slot.count = static_cast<int>(take<std::uint16_t>(cursor));
+    return slot;
+}
+
+bool sameSlot(const entities::InventorySlot& a, const entities::InventorySlot& b) {
+    return a.category == b.category && a.blockType == b.blockType && a.toolKind == b.toolKind
+        && a.toolTier == b.toolTier && a.armorId == b.armorId && a.accessoryId == b.accessoryId && a.count == b.count;
+}
+
+void syncFile(std::FILE* file) {
+    std::fflush(file);
+#if defined(_WIN32)
+    _commit(_fileno(file));
+#else
+    ::fsync(::fileno(file));
+#endif
+}
+
+} // namespace
+
+EditLog::EditLog(int flushIntervalMs)
+    : flushIntervalMs_{std::max(1, flushIntervalMs)} {}
+
+EditLog::~EditLog() {
+    close();
+}
+
+bool EditLog::open(const std::filesystem::path& directory, const std::string& name) {
+    close();
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    directory_ = directory;
+    name_ = name;
+    generation_ = 0;
+    for (const auto& segment : segments(directory_, name_)) {
+        generation_ = std::max(generation_, segment.first);
+    }
+    ++generation_;
+    if (!openSegment(generation_)) {
+        return false;
+    }
+    hasPlayerRecord_ = false;
+    pending_.clear();
+    sealed_.clear();
+    discardThrough_ = 0;
+    discarded_ = 0;
+    stopping_ = false;
+    open_ = true;
+    flusher_ = std::thread([this]() { flushLoop(); });
+    return true;
+}
+
+void EditLog::close() {
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+    drain();
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    open_ = false;
+}
+
+void EditLog::appendTile(int x, int y, std::uint8_t cell) {
+    if (!open_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    put(pending_, kTileRecord);
+    put(pending_, static_cast<std::int32_t>(x));
+    put(pending_, static_cast<std::int32_t>(y));
+    put(pending_, cell);
+}
+
+void EditLog::appendPlayer(const entities::Player& player) {
+    if (!open_) {
+        return;
+    }
+    PlayerRecord record{};
+    record.health = player.health();
+    std::copy(player.inventory().begin(), player.inventory().end(), record.inventory.begin());
+    record.ammo = player.ammoSlot();
+
+    bool stateChanged = !hasPlayerRecord_ || record.health != lastPlayer_.health || !sameSlot(record.ammo, lastPlayer_.ammo);
+    for (std::size_t i = 0; i < record.inventory.size() && !stateChanged; ++i) {
+        stateChanged = !sameSlot(record.inventory[i], lastPlayer_.inventory[i]);
+    }
+    if (!stateChanged) {
+        return;
+    }
+    hasPlayerRecord_ = true;
+    lastPlayer_ = record;
+
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    put(pending_, kPlayerRecord);
+    put(pending_, static_cast<std::int32_t>(record.health));
+    for (const auto& slot : record.inventory) {
+        putSlot(pending_, slot);
+    }
+    putSlot(pending_, record.ammo);
+}
+
+std::uint64_t EditLog::rotate() {
+    if (!open_) {
+        return 0;
+    }
+    const std::uint64_t closed = generation_++;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        sealed_.push_back({closed, {}});
+        sealed_.back().tail.swap(pending_);
+    }
+    wake_.notify_one();
+    hasPlayerRecord_ = false;
+    return closed;
+}
+
+void EditLog::discardThrough(std::uint64_t generation) {
+    if (generation == 0 || !open_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        discardThrough_ = std::max(discardThrough_, generation);
+    }
+    wake_.notify_one();
+}
+
+bool EditLog::replay(const std::filesystem::path& directory,
+                     const std::string& name,
+                     world::World* world,
+                     entities::Player* player) {
+    bool applied = false;
+    for (const auto& segment : segments(directory, name)) {
+        std::ifstream in(segment.second, std::ios::binary);
+        const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        const std::uint8_t* cursor = bytes.data();
+        const std::uint8_t* end = bytes.data() + bytes.size();
+        while (cursor < end) {
+            const std::uint8_t tag = *cursor;
+            const auto remaining = static_cast<std::size_t>(end - cursor);
+            if (tag == kTileRecord && remaining >= kTileRecordBytes) {
+                ++cursor;
+                const auto x = take<std::int32_t>(cursor);
+                const auto y = take<std::int32_t>(cursor);
+                const auto cell = take<std::uint8_t>(cursor);
+                if (world && x >= 0 && y >= 0 && x < world->width() && y < world->height()) {
+                    world->setTile(x, y, static_cast<world::TileType>(cell & world::kTileTypeMask),
+                                   (cell & world::kTileActiveBit) != 0);
+                    applied = true;
+                }
+            } else if (tag == kPlayerRecord && remaining >= kPlayerRecordBytes) {
+                ++cursor;
+                const auto health = take<std::int32_t>(cursor);
+                std::array<entities::InventorySlot, entities::kInventorySlots> inventory{};
+                for (auto& slot : inventory) {
+                    slot = takeSlot(cursor);
+                }
+                const entities::InventorySlot ammo = takeSlot(cursor);
+                if (player) {
+                    player->setHealth(static_cast<int>(health));
+                    std::copy(inventory.begin(), inventory.end(), player->inventory().begin());
+                    player->ammoSlot() = ammo;
+                    applied = true;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+    return applied;
+}
+
+std::vector<std::pair<std::uint64_t, std::filesystem::path>> EditLog::segments(const std::filesystem::path& directory,
+                                                                               const std::string& name) {
+    std::vector<std::pair<std::uint64_t, std::filesystem::path>> result;
+    std::error_code ec;
+    const std::string prefix = name + ".";
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        const auto path = entry.path();
+        if (path.extension() != ".wal") {
+            continue;
+        }
+        const std::string stem = path.stem().string();
+        if (stem.size() <= prefix.size() || stem.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        const std::string digits = stem.substr(prefix.size());
+        if (!std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+        result.emplace_back(std::stoull(digits), path);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::filesystem::path EditLog::segmentPath(std::uint64_t generation) const {
+    return directory_ / (name_ + "." + std::to_string(generation) + ".wal");
+}
+
+bool EditLog::openSegment(std::uint64_t generation) {
+    file_ = std::fopen(segmentPath(generation).string().c_str(), "ab");
+    fileGeneration_ = generation;
+    return file_ != nullptr;
+}
+
+// Writes out everything handed over so far: sealed segments are finished, synced and replaced by
+// the next one, then the open segment gets the pending records and covered segments are deleted.
+void EditLog::drain() {
+    std::vector<SealedSegment> sealed;
+    std::vector<std::uint8_t> batch;
+    std::uint64_t discardThrough = 0;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        sealed.swap(sealed_);
+        batch.swap(pending_);
+        if (discardThrough_ > discarded_) {
+            discardThrough = discardThrough_;
+            discarded_ = discardThrough_;
+        }
+    }
+    for (const auto& segment : sealed) {
+        if (file_ && fileGeneration_ == segment.generation) {
+            if (!segment.tail.empty()) {
+                std::fwrite(segment.tail.data(), 1, segment.tail.size(), file_);
+            }
+            syncFile(file_);
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+        openSegment(segment.generation + 1);
+    }
+    if (file_) {
+        if (!batch.empty()) {
+            std::fwrite(batch.data(), 1, batch.size(), file_);
+        }
+        syncFile(file_);
+    }
+    if (discardThrough > 0) {
+        std::error_code ec;
+        for (const auto& segment : segments(directory_, name_)) {
+            if (segment.first <= discardThrough && segment.first < fileGeneration_) {
+                std::filesystem::remove(segment.second, ec);
+            }
+        }
+    }
+}
+
+void EditLog::flushLoop() {
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    while (!stopping_) {
+        wake_.wait_for(lock, std::chrono::milliseconds(flushIntervalMs_), [this]() {
+            return stopping_ || !sealed_.empty() || discardThrough_ > discarded_;
+        });
+        if (stopping_) {
+            break;
+        }
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+} // namespace terraria::game
@@ -3,7 +3,6 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <limits>
 
 namespace terraria::game {
 
@@ -12,7 +11,6 @@ constexpr float kGravity = 60.0F;
 constexpr float kZombieMoveSpeed = 6.0F;
 constexpr float kZombieSpawnIntervalMin = 3.0F;
 constexpr float kZombieSpawnIntervalMax = 6.0F;
-constexpr int kMaxZombies = 12;
 constexpr int kZombieDamage = 14;
 constexpr float kZombieAttackInterval = 1.2F;
 constexpr float kZombieJumpVelocity = 22.0F;
@@ -21,7 +19,6 @@ constexpr float kTilePixels = 16.0F;
 constexpr float kFlyerMoveSpeed = 7.5F;
 constexpr float kFlyerSpawnIntervalMin = 4.0F;
 constexpr float kFlyerSpawnIntervalMax = 7.0F;
-constexpr int kMaxFlyers = 8;
 constexpr int kFlyerDamage = 10;
 constexpr float kFlyerAttackInterval = 1.6F;
 constexpr float kFlyerProjectileSpeed = 12.0F;
@@ -38,7 +35,6 @@ constexpr float kWormAirTime = 1.2F;
 constexpr float kWormLungeCooldown = 1.6F;
 constexpr float kWormSpawnIntervalMin = 5.0F;
 constexpr float kWormSpawnIntervalMax = 9.0F;
-constexpr int kMaxWorms = 6;
 constexpr int kWormDamage = 18;
 constexpr float kWormAttackInterval = 1.0F;
 constexpr int kWormCoinMin = 3;
@@ -89,14 +85,21 @@ EnemyManager::EnemyManager(const core::AppConfig& config,
       player_{player},
       physics_{physics},
       damageNumbers_{damageNumbers},
-      rng_{static_cast<std::uint32_t>(config.worldWidth * 313 + config.worldHeight * 197)} {
+      flowField_{world, physics} {
+    seed(static_cast<std::uint64_t>(config.worldWidth * 313 + config.worldHeight * 197));
     dragon_.health = 0;
     std::uniform_real_distribution<float> zombieTimerDist(kZombieSpawnIntervalMin, kZombieSpawnIntervalMax);
     std::uniform_real_distribution<float> flyerTimerDist(kFlyerSpawnIntervalMin, kFlyerSpawnIntervalMax);
     std::uniform_real_distribution<float> wormTimerDist(kWormSpawnIntervalMin, kWormSpawnIntervalMax);
-    spawnTimerZombies_ = zombieTimerDist(rng_);
-    spawnTimerFlyers_ = flyerTimerDist(rng_);
-    spawnTimerWorms_ = wormTimerDist(rng_);
+    spawnTimerZombies_ = zombieTimerDist(spawnRng_);
+    spawnTimerFlyers_ = flyerTimerDist(spawnRng_);
+    spawnTimerWorms_ = wormTimerDist(spawnRng_);
+}
+
+void EnemyManager::seed(std::uint64_t seed) {
+    spawnRng_.seed(core::StreamSeed(seed, 1));
+    lootRng_.seed(core::StreamSeed(seed, 2));
+    attackRng_.seed(core::StreamSeed(seed, 3));
 }
 
 void EnemyManager::reset() {
@@ -106,6 +109,8 @@ void EnemyManager::reset() {
     dragon_ = {};
     dragon_.health = 0;
     enemyProjectiles_.clear();
+    colliders_.clear();
+    flowField_.clear();
     spawnTimerZombies_ = 0.0F;
     spawnTimerFlyers_ = 0.0F;
     spawnTimerWorms_ = 0.0F;
@@ -136,15 +141,69 @@ EnemyManager::ViewBounds EnemyManager::computeViewBounds(const entities::Vec2& c
                       tilesTall};
 }
 
-void EnemyManager::update(float dt, bool isNight, const entities::Vec2& cameraFocus) {
-    const auto view = computeViewBounds(cameraFocus);
+void EnemyManager::update(float dt, bool isNight, const entities::Vec2& cameraFocus, BodyStore& bodies) {
+    view_ = computeViewBounds(cameraFocus);
     swoopTimer_ += dt;
 
-    updateZombies(dt, isNight, view);
-    updateFlyers(dt, isNight, view);
-    updateWorms(dt, view);
-    updateDragon(dt);
-    updateEnemyProjectiles(dt);
+    updateZombies(dt, isNight, view_, bodies);
+    updateFlyers(dt, isNight, view_, bodies);
+    updateWorms(dt, view_, bodies);
+    updateDragon(dt, bodies);
+    updateEnemyProjectiles(dt, bodies);
+}
+
+void EnemyManager::resolve(bool isNight, const BodyStore& bodies) {
+    resolveZombies(isNight, bodies);
+    resolveFlyers(isNight, bodies);
+    resolveWorms(bodies);
+    resolveDragon(bodies);
+    resolveEnemyProjectiles(bodies);
+    indexColliders();
+}
+
+void EnemyManager::indexColliders() {
+    colliders_.clear();
+    for (std::size_t i = 0; i < zombies_.size(); ++i) {
+        if (zombies_.alive(i)) {
+            colliders_.insert(ColliderKind::Zombie,
+                              static_cast<int>(i),
+                              zombies_.position[i],
+                              entities::kZombieHalfWidth,
+                              entities::kZombieHeight);
+        }
+    }
+    for (std::size_t i = 0; i < flyers_.size(); ++i) {
+        if (flyers_.alive(i)) {
+            colliders_.insert(ColliderKind::Flyer,
+                              static_cast<int>(i),
+                              flyers_.position[i],
+                              entities::kFlyingEnemyRadius,
+                              entities::kFlyingEnemyRadius * 2.0F);
+        }
+    }
+    for (std::size_t i = 0; i < worms_.size(); ++i) {
+        if (worms_.alive(i)) {
+            colliders_.insert(ColliderKind::Worm,
+                              static_cast<int>(i),
+                              worms_.position[i],
+                              entities::kWormRadius,
+                              entities::kWormRadius * 2.0F);
+        }
+    }
+    if (dragonActive_ && dragon_.alive()) {
+        colliders_.insert(ColliderKind::Dragon, 0, dragon_.position, entities::kDragonHalfWidth, entities::kDragonHeight);
+    }
+    for (std::size_t i = 0; i < enemyProjectiles_.size(); ++i) {
+        const auto& projectile = enemyProjectiles_[i];
+        if (projectile.lifetime > 0.0F) {
+            colliders_.insert(ColliderKind::EnemyProjectile,
+                              static_cast<int>(i),
+                              projectile.position,
+                              projectile.radius,
+                              projectile.radius * 2.0F);
+        }
+    }
+    colliders_.build();
 }
 
 void EnemyManager::setDragonDen(const entities::Vec2& center, float radiusX, float radiusY) {
@@ -170,16 +229,10 @@ void EnemyManager::setDragonDen(const entities::Vec2& center, float radiusX, flo
 
 bool EnemyManager::removeEnemyProjectilesInBox(const entities::Vec2& center, float halfWidth, float halfHeight) {
     bool removed = false;
-    for (auto& projectile : enemyProjectiles_) {
-        if (projectile.lifetime <= 0.0F) {
-            continue;
-        }
-        if (physics_.aabbOverlap(center,
-                                 halfWidth,
-                                 halfHeight,
-                                 projectile.position,
-                                 projectile.radius,
-                                 projectile.radius * 2.0F)) {
+    colliders_.queryBox(center, halfWidth, halfHeight, ColliderBit(ColliderKind::EnemyProjectile), queryResults_);
+    for (const int id : queryResults_) {
+        auto& projectile = enemyProjectiles_[static_cast<std::size_t>(colliders_.collider(id).index)];
+        if (projectile.lifetime > 0.0F) {
             projectile.lifetime = 0.0F;
             removed = true;
         }
@@ -187,58 +240,53 @@ bool EnemyManager::removeEnemyProjectilesInBox(const entities::Vec2& center, flo
     return removed;
 }
 
-bool EnemyManager::removeEnemyProjectileAt(const entities::Vec2& position, float radius) {
-    bool removed = false;
-    for (auto& projectile : enemyProjectiles_) {
-        if (projectile.lifetime <= 0.0F) {
-            continue;
-        }
-        if (projectile.fromDragon) {
-            continue;
-        }
-        if (physics_.aabbOverlap(position,
-                                 radius,
-                                 radius * 2.0F,
-                                 projectile.position,
-                                 projectile.radius,
-                                 projectile.radius * 2.0F)) {
-            projectile.lifetime = 0.0F;
-            removed = true;
-        }
+bool EnemyManager::removeEnemyProjectile(int index) {
+    auto& projectile = enemyProjectiles_[static_cast<std::size_t>(index)];
+    if (projectile.lifetime <= 0.0F || projectile.fromDragon) {
+        return false;
     }
-    return removed;
+    projectile.lifetime = 0.0F;
+    return true;
 }
 
-void EnemyManager::updateZombies(float dt, bool isNight, const ViewBounds& view) {
+void EnemyManager::updateZombies(float dt, bool isNight, const ViewBounds& view, BodyStore& bodies) {
     if (spawnTimerZombies_ > 0.0F) {
         spawnTimerZombies_ -= dt;
     }
-    if (isNight && spawnTimerZombies_ <= 0.0F && static_cast<int>(zombies_.size()) < kMaxZombies) {
+    if (isNight && spawnTimerZombies_ <= 0.0F && static_cast<int>(zombies_.size()) < config_.maxZombies) {
         spawnZombie(view);
         std::uniform_real_distribution<float> timerDist(kZombieSpawnIntervalMin, kZombieSpawnIntervalMax);
-        spawnTimerZombies_ = timerDist(rng_);
+        spawnTimerZombies_ = timerDist(spawnRng_);
     } else if (!isNight) {
         spawnTimerZombies_ = 0.0F;
     }
 
-    for (auto& zombie : zombies_) {
-        if (!zombie.alive()) {
+    if (isNight && !zombies_.empty()) {
+        flowField_.update(player_.position());
+    }
+    const BodyBounds worldBounds{0.0F, 0.0F, static_cast<float>(world_.width() - 1), static_cast<float>(world_.height() - 1)};
+    for (std::size_t i = 0; i < zombies_.size(); ++i) {
+        auto& zombie = zombies_.state[i];
+        entities::Vec2& position = zombies_.position[i];
+        entities::Vec2& velocity = zombies_.velocity[i];
+        zombies_.body[i] = kNoBody;
+        if (!zombies_.alive(i)) {
             if (!zombie.droppedLoot) {
-                const int drop = std::uniform_int_distribution<int>(kZombieCoinMin, kZombieCoinMax)(rng_);
+                const int drop = std::uniform_int_distribution<int>(kZombieCoinMin, kZombieCoinMax)(lootRng_);
                 player_.addToInventory(world::TileType::Coin, drop);
-                damageNumbers_.addLoot(zombie.position, drop);
+                damageNumbers_.addLoot(position, drop);
                 zombie.droppedLoot = true;
             }
             continue;
         }
-        const bool onScreen = zombie.position.x >= static_cast<float>(view.startX)
-            && zombie.position.x <= static_cast<float>(view.startX + view.tilesWide)
-            && zombie.position.y >= static_cast<float>(view.startY)
-            && zombie.position.y <= static_cast<float>(view.startY + view.tilesTall);
+        const bool onScreen = position.x >= static_cast<float>(view.startX)
+            && position.x <= static_cast<float>(view.startX + view.tilesWide)
+            && position.y >= static_cast<float>(view.startY)
+            && position.y <= static_cast<float>(view.startY + view.tilesTall);
         if (!onScreen) {
             zombie.offscreenTimer += dt;
             if (zombie.offscreenTimer >= kOffscreenDespawnTime) {
-                zombie.health = 0;
+                zombies_.health[i] = 0;
                 continue;
             }
         } else {
@@ -247,10 +295,10 @@ void EnemyManager::updateZombies(float dt, bool isNight, const ViewBounds& view)
         if (!isNight) {
             const int margin = 8;
             const float viewCenterX = static_cast<float>(view.startX) + static_cast<float>(view.tilesWide) * 0.5F;
-            zombie.desiredDir = (zombie.position.x < viewCenterX) ? -1 : 1;
-            if (zombie.position.x < static_cast<float>(view.startX - margin)
-                || zombie.position.x > static_cast<float>(view.startX + view.tilesWide + margin)) {
-                zombie.health = 0;
+            zombie.desiredDir = (position.x < viewCenterX) ? -1 : 1;
+            if (position.x < static_cast<float>(view.startX - margin)
+                || position.x > static_cast<float>(view.startX + view.tilesWide + margin)) {
+                zombies_.health[i] = 0;
                 continue;
             }
         }
@@ -258,14 +306,33 @@ void EnemyManager::updateZombies(float dt, bool isNight, const ViewBounds& view)
         zombie.lungeCooldown = std::max(0.0F, zombie.lungeCooldown - dt);
         zombie.lungeTimer = std::max(0.0F, zombie.lungeTimer - dt);
         if (isNight) {
-            zombie.pathTimer -= dt;
-            if (zombie.pathTimer <= 0.0F) {
-                zombie.desiredDir = computeZombiePathDirection(zombie);
-                zombie.pathTimer = 0.4F;
-            }
+            zombie.desiredDir = flowField_.direction(position);
+        }
+        steerZombie(i, dt);
+        const std::uint8_t flags = zombie.onGround ? static_cast<std::uint8_t>(kBodyCollides | kBodyOnGround) : kBodyCollides;
+        zombies_.body[i] = bodies.add(position,
+                                      velocity,
+                                      entities::kZombieHalfWidth,
+                                      entities::kZombieHeight,
+                                      kGravity,
+                                      flags,
+                                      worldBounds);
+    }
+}
+
+void EnemyManager::resolveZombies(bool isNight, const BodyStore& bodies) {
+    for (std::size_t i = 0; i < zombies_.size(); ++i) {
+        auto& zombie = zombies_.state[i];
+        entities::Vec2& position = zombies_.position[i];
+        entities::Vec2& velocity = zombies_.velocity[i];
+        if (zombies_.body[i] == kNoBody) {
+            continue;
         }
-        applyZombiePhysics(zombie, dt);
-        if (isNight && physics_.aabbOverlap(zombie.position,
+        position = bodies.position(zombies_.body[i]);
+        velocity = bodies.velocity(zombies_.body[i]);
+        zombie.onGround = bodies.has(zombies_.body[i], kBodyOnGround);
+        zombie.lastX = position.x;
+        if (isNight && physics_.aabbOverlap(position,
                                             entities::kZombieHalfWidth,
                                             entities::kZombieHeight,
                                             player_.position(),
@@ -275,7 +342,7 @@ void EnemyManager::updateZombies(float dt, bool isNight, const ViewBounds& view)
             const int dealt = player_.applyDamage(kZombieDamage);
             damageNumbers_.addDamage(player_.position(), dealt, true);
             zombie.attackCooldown = kZombieAttackInterval * 0.85F;
-            const float dir = (player_.position().x < zombie.position.x) ? -1.0F : 1.0F;
+            const float dir = (player_.position().x < position.x) ? -1.0F : 1.0F;
             entities::Vec2 knock = player_.velocity();
             knock.x += dir * 7.0F;
             knock.y = -8.0F;
@@ -283,41 +350,44 @@ void EnemyManager::updateZombies(float dt, bool isNight, const ViewBounds& view)
         }
     }
 
-    zombies_.erase(
-        std::remove_if(zombies_.begin(), zombies_.end(), [](const entities::Zombie& zombie) { return !zombie.alive(); }),
-        zombies_.end());
+    zombies_.removeDead();
 }
 
-void EnemyManager::updateFlyers(float dt, bool isNight, const ViewBounds& view) {
+void EnemyManager::updateFlyers(float dt, bool isNight, const ViewBounds& view, BodyStore& bodies) {
     if (spawnTimerFlyers_ > 0.0F) {
         spawnTimerFlyers_ -= dt;
     }
-    if (isNight && spawnTimerFlyers_ <= 0.0F && static_cast<int>(flyers_.size()) < kMaxFlyers) {
+    if (isNight && spawnTimerFlyers_ <= 0.0F && static_cast<int>(flyers_.size()) < config_.maxFlyers) {
         spawnFlyer(view);
         std::uniform_real_distribution<float> timerDist(kFlyerSpawnIntervalMin, kFlyerSpawnIntervalMax);
-        spawnTimerFlyers_ = timerDist(rng_);
+        spawnTimerFlyers_ = timerDist(spawnRng_);
     } else if (!isNight) {
         spawnTimerFlyers_ = 0.0F;
     }
 
-    for (auto& flyer : flyers_) {
-        if (!flyer.alive()) {
+    const BodyBounds nightBounds{0.5F, 1.0F, static_cast<float>(world_.width() - 1), static_cast<float>(world_.height() - 2)};
+    for (std::size_t i = 0; i < flyers_.size(); ++i) {
+        auto& flyer = flyers_.state[i];
+        entities::Vec2& position = flyers_.position[i];
+        entities::Vec2& velocity = flyers_.velocity[i];
+        flyers_.body[i] = kNoBody;
+        if (!flyers_.alive(i)) {
             if (!flyer.droppedLoot) {
-                const int drop = std::uniform_int_distribution<int>(kFlyerCoinMin, kFlyerCoinMax)(rng_);
+                const int drop = std::uniform_int_distribution<int>(kFlyerCoinMin, kFlyerCoinMax)(lootRng_);
                 player_.addToInventory(world::TileType::Coin, drop);
-                damageNumbers_.addLoot(flyer.position, drop);
+                damageNumbers_.addLoot(position, drop);
                 flyer.droppedLoot = true;
             }
             continue;
         }
-        const bool onScreen = flyer.position.x >= static_cast<float>(view.startX)
-            && flyer.position.x <= static_cast<float>(view.startX + view.tilesWide)
-            && flyer.position.y >= static_cast<float>(view.startY)
-            && flyer.position.y <= static_cast<float>(view.startY + view.tilesTall);
+        const bool onScreen = position.x >= static_cast<float>(view.startX)
+            && position.x <= static_cast<float>(view.startX + view.tilesWide)
+            && position.y >= static_cast<float>(view.startY)
+            && position.y <= static_cast<float>(view.startY + view.tilesTall);
         if (!onScreen) {
             flyer.offscreenTimer += dt;
             if (flyer.offscreenTimer >= kOffscreenDespawnTime) {
-                flyer.health = 0;
+                flyers_.health[i] = 0;
                 continue;
             }
         } else {
@@ -327,54 +397,75 @@ void EnemyManager::updateFlyers(float dt, bool isNight, const ViewBounds& view)
         flyer.contactCooldown = std::max(0.0F, flyer.contactCooldown - dt);
 
         if (!isNight) {
-            const int margin = 10;
             const float viewCenterX = static_cast<float>(view.startX) + static_cast<float>(view.tilesWide) * 0.5F;
-            const float fleeDir = (flyer.position.x < viewCenterX) ? -1.0F : 1.0F;
-            flyer.velocity.x = fleeDir * kFlyerMoveSpeed;
-            flyer.velocity.y = -kFlyerMoveSpeed * 0.4F;
-            if (flyer.position.x < static_cast<float>(view.startX - margin)
-                || flyer.position.x > static_cast<float>(view.startX + view.tilesWide + margin)
-                || flyer.position.y < static_cast<float>(view.startY - margin)) {
-                flyer.health = 0;
-            }
-            flyer.position.x += flyer.velocity.x * dt;
-            flyer.position.y += flyer.velocity.y * dt;
+            const float fleeDir = (position.x < viewCenterX) ? -1.0F : 1.0F;
+            velocity.x = fleeDir * kFlyerMoveSpeed;
+            velocity.y = -kFlyerMoveSpeed * 0.4F;
+            flyers_.body[i] = bodies.add(position,
+                                         velocity,
+                                         entities::kFlyingEnemyRadius,
+                                         entities::kFlyingEnemyRadius * 2.0F,
+                                         0.0F,
+                                         0);
             continue;
         }
 
         if (flyer.knockbackTimer > 0.0F) {
-            flyer.velocity.x = flyer.knockbackVelocity;
-            flyer.velocity.y = std::min(flyer.velocity.y, -2.0F);
+            velocity.x = flyer.knockbackVelocity;
+            velocity.y = std::min(velocity.y, -2.0F);
             flyer.knockbackVelocity *= 0.88F;
             flyer.knockbackTimer = std::max(0.0F, flyer.knockbackTimer - dt);
         } else {
-            const float phase = swoopTimer_ * 1.35F + static_cast<float>(flyer.id) * 0.7F;
+            const float phase = swoopTimer_ * 1.35F + static_cast<float>(flyers_.id[i]) * 0.7F;
             const float sweepX = std::cos(phase) * 4.0F;
             const float sweepY = std::sin(phase * 1.4F) * 3.0F;
             const entities::Vec2 target{player_.position().x + sweepX,
                                         player_.position().y - 4.5F + sweepY};
-            entities::Vec2 delta{target.x - flyer.position.x, target.y - flyer.position.y};
+            entities::Vec2 delta{target.x - position.x, target.y - position.y};
             const float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
             if (distance > 0.01F) {
                 delta.x /= distance;
                 delta.y /= distance;
-                flyer.velocity.x = delta.x * kFlyerMoveSpeed;
-                flyer.velocity.y = delta.y * kFlyerMoveSpeed;
+                velocity.x = delta.x * kFlyerMoveSpeed;
+                velocity.y = delta.y * kFlyerMoveSpeed;
             } else {
-                flyer.velocity = {0.0F, 0.0F};
+                velocity = {0.0F, 0.0F};
             }
         }
 
-        flyer.position.x += flyer.velocity.x * dt;
-        flyer.position.y += flyer.velocity.y * dt;
-        flyer.position.x = std::clamp(flyer.position.x, 0.5F, static_cast<float>(world_.width() - 1));
-        flyer.position.y = std::clamp(flyer.position.y, 1.0F, static_cast<float>(world_.height() - 2));
+        flyers_.body[i] = bodies.add(position,
+                                     velocity,
+                                     entities::kFlyingEnemyRadius,
+                                     entities::kFlyingEnemyRadius * 2.0F,
+                                     0.0F,
+                                     0,
+                                     nightBounds);
+    }
+}
 
-        if (physics_.solidAtPosition(flyer.position)) {
-            flyer.position.y = std::max(1.0F, flyer.position.y - 0.5F);
+void EnemyManager::resolveFlyers(bool isNight, const BodyStore& bodies) {
+    for (std::size_t i = 0; i < flyers_.size(); ++i) {
+        auto& flyer = flyers_.state[i];
+        entities::Vec2& position = flyers_.position[i];
+        if (flyers_.body[i] == kNoBody) {
+            continue;
+        }
+        position = bodies.position(flyers_.body[i]);
+        if (!isNight) {
+            const int margin = 10;
+            if (position.x < static_cast<float>(view_.startX - margin)
+                || position.x > static_cast<float>(view_.startX + view_.tilesWide + margin)
+                || position.y < static_cast<float>(view_.startY - margin)) {
+                flyers_.health[i] = 0;
+            }
+            continue;
+        }
+
+        if (physics_.solidAtPosition(position)) {
+            position.y = std::max(1.0F, position.y - 0.5F);
         }
 
-        if (physics_.aabbOverlap(flyer.position,
+        if (physics_.aabbOverlap(position,
                                  entities::kFlyingEnemyRadius,
                                  entities::kFlyingEnemyRadius * 2.0F,
                                  player_.position(),
@@ -383,7 +474,7 @@ void EnemyManager::updateFlyers(float dt, bool isNight, const ViewBounds& view)
             && flyer.contactCooldown <= 0.0F) {
             const int dealt = player_.applyDamage(kFlyerDamage);
             damageNumbers_.addDamage(player_.position(), dealt, true);
-            const float dir = (player_.position().x < flyer.position.x) ? -1.0F : 1.0F;
+            const float dir = (player_.position().x < position.x) ? -1.0F : 1.0F;
             entities::Vec2 knock = player_.velocity();
             knock.x += dir * 7.5F;
             knock.y = -8.5F;
@@ -393,10 +484,11 @@ void EnemyManager::updateFlyers(float dt, bool isNight, const ViewBounds& view)
             flyer.contactCooldown = 0.9F;
         }
 
-        entities::Vec2 toPlayer{player_.position().x - flyer.position.x,
-                                player_.position().y - flyer.position.y};
+        entities::Vec2 toPlayer{player_.position().x - position.x,
+                                player_.position().y - position.y};
         const float fireDistance = std::sqrt(toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y);
-        if (fireDistance < 10.0F && flyer.attackCooldown <= 0.0F) {
+        const entities::Vec2 playerCenter{player_.position().x, player_.position().y - entities::kPlayerHeight * 0.5F};
+        if (fireDistance < 10.0F && flyer.attackCooldown <= 0.0F && physics_.lineOfSight(position, playerCenter)) {
             entities::Vec2 dir = toPlayer;
             const float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
             if (len > 0.01F) {
@@ -406,54 +498,58 @@ void EnemyManager::updateFlyers(float dt, bool isNight, const ViewBounds& view)
                 dir = {1.0F, 0.0F};
             }
             EnemyProjectile projectile{};
-            projectile.position = flyer.position;
+            projectile.position = position;
             projectile.velocity = {dir.x * kFlyerProjectileSpeed, dir.y * kFlyerProjectileSpeed};
             projectile.lifetime = kFlyerProjectileLifetime;
             projectile.radius = 0.18F;
             projectile.damage = kFlyerDamage;
             projectile.isFlame = false;
             projectile.fromDragon = false;
+            projectile.previousPosition = projectile.position;
             enemyProjectiles_.push_back(projectile);
             flyer.attackCooldown = kFlyerAttackInterval;
         }
     }
 
-    flyers_.erase(
-        std::remove_if(flyers_.begin(), flyers_.end(), [](const entities::FlyingEnemy& enemy) { return !enemy.alive(); }),
-        flyers_.end());
+    flyers_.removeDead();
 }
 
-void EnemyManager::updateWorms(float dt, const ViewBounds& view) {
+void EnemyManager::updateWorms(float dt, const ViewBounds& view, BodyStore& bodies) {
     const bool underground = player_.position().y > static_cast<float>(world_.height()) * kWormSpawnDepthRatio;
     if (spawnTimerWorms_ > 0.0F) {
         spawnTimerWorms_ -= dt;
     }
-    if (underground && spawnTimerWorms_ <= 0.0F && static_cast<int>(worms_.size()) < kMaxWorms) {
+    if (underground && spawnTimerWorms_ <= 0.0F && static_cast<int>(worms_.size()) < config_.maxWorms) {
         spawnWorm(view);
         std::uniform_real_distribution<float> timerDist(kWormSpawnIntervalMin, kWormSpawnIntervalMax);
-        spawnTimerWorms_ = timerDist(rng_);
+        spawnTimerWorms_ = timerDist(spawnRng_);
     } else if (!underground) {
         spawnTimerWorms_ = 0.0F;
     }
 
-    for (auto& worm : worms_) {
-        if (!worm.alive()) {
+    const BodyBounds wormBounds{0.5F, 2.0F, static_cast<float>(world_.width() - 1), static_cast<float>(world_.height() - 2)};
+    for (std::size_t i = 0; i < worms_.size(); ++i) {
+        auto& worm = worms_.state[i];
+        entities::Vec2& position = worms_.position[i];
+        entities::Vec2& velocity = worms_.velocity[i];
+        worms_.body[i] = kNoBody;
+        if (!worms_.alive(i)) {
             if (!worm.droppedLoot) {
-                const int drop = std::uniform_int_distribution<int>(kWormCoinMin, kWormCoinMax)(rng_);
+                const int drop = std::uniform_int_distribution<int>(kWormCoinMin, kWormCoinMax)(lootRng_);
                 player_.addToInventory(world::TileType::Coin, drop);
-                damageNumbers_.addLoot(worm.position, drop);
+                damageNumbers_.addLoot(position, drop);
                 worm.droppedLoot = true;
             }
             continue;
         }
-        const bool onScreen = worm.position.x >= static_cast<float>(view.startX)
-            && worm.position.x <= static_cast<float>(view.startX + view.tilesWide)
-            && worm.position.y >= static_cast<float>(view.startY)
-            && worm.position.y <= static_cast<float>(view.startY + view.tilesTall);
+        const bool onScreen = position.x >= static_cast<float>(view.startX)
+            && position.x <= static_cast<float>(view.startX + view.tilesWide)
+            && position.y >= static_cast<float>(view.startY)
+            && position.y <= static_cast<float>(view.startY + view.tilesTall);
         if (!onScreen) {
             worm.offscreenTimer += dt;
             if (worm.offscreenTimer >= kOffscreenDespawnTime) {
-                worm.health = 0;
+                worms_.health[i] = 0;
                 continue;
             }
         } else {
@@ -463,10 +559,10 @@ void EnemyManager::updateWorms(float dt, const ViewBounds& view) {
         worm.attackCooldown = std::max(0.0F, worm.attackCooldown - dt);
         worm.lungeCooldown = std::max(0.0F, worm.lungeCooldown - dt);
 
-        const int solidTileX = static_cast<int>(std::floor(worm.position.x));
-        const int solidTileY = static_cast<int>(std::floor(worm.position.y));
+        const int solidTileX = static_cast<int>(std::floor(position.x));
+        const int solidTileY = static_cast<int>(std::floor(position.y));
         const bool inSolid = physics_.isSolidTile(solidTileX, solidTileY);
-        const bool overlappingPlayer = physics_.aabbOverlap(worm.position,
+        const bool overlappingPlayer = physics_.aabbOverlap(position,
                                                             entities::kWormRadius,
                                                             entities::kWormRadius * 2.0F,
                                                             player_.position(),
@@ -475,26 +571,29 @@ void EnemyManager::updateWorms(float dt, const ViewBounds& view) {
 
         entities::Vec2 desiredDir{0.0F, 0.0F};
         bool hasDesiredDir = false;
+        float gravity = 0.0F;
         if (worm.airTimer > 0.0F) {
             worm.airTimer = std::max(0.0F, worm.airTimer - dt);
-            const float gravity = (worm.velocity.y < 0.0F) ? kWormAirGravityUp : kWormAirGravity;
-            worm.velocity.y += gravity * dt;
+            gravity = (velocity.y < 0.0F) ? kWormAirGravityUp : kWormAirGravity;
         } else if (worm.knockbackTimer > 0.0F) {
-            worm.velocity.x = worm.knockbackVelocity;
+            velocity.x = worm.knockbackVelocity;
             worm.knockbackVelocity *= 0.9F;
             worm.knockbackTimer = std::max(0.0F, worm.knockbackTimer - dt);
         } else {
-            const float phase = swoopTimer_ * 1.6F + static_cast<float>(worm.id) * 0.6F;
+            const float phase = swoopTimer_ * 1.6F + static_cast<float>(worms_.id[i]) * 0.6F;
             const float offsetX = std::sin(phase) * 2.0F;
             const float offsetY = std::cos(phase) * 1.5F;
             const entities::Vec2 target{player_.position().x + offsetX, player_.position().y + 2.5F + offsetY};
-            entities::Vec2 delta{target.x - worm.position.x, target.y - worm.position.y};
-            for (const auto& other : worms_) {
-                if (&other == &worm || !other.alive()) {
+            entities::Vec2 delta{target.x - position.x, target.y - position.y};
+            // Neighbours come from the colliders indexed at the last resolve, so this stays linear in worms.
+            colliders_.queryCircle(position, kWormSeparationRadius, ColliderBit(ColliderKind::Worm), queryResults_);
+            for (const int colliderId : queryResults_) {
+                const auto other = static_cast<std::size_t>(colliders_.collider(colliderId).index);
+                if (other == i || other >= worms_.size() || !worms_.alive(other)) {
                     continue;
                 }
-                const float dx = worm.position.x - other.position.x;
-                const float dy = worm.position.y - other.position.y;
+                const float dx = position.x - worms_.position[other].x;
+                const float dy = position.y - worms_.position[other].y;
                 const float distSq = dx * dx + dy * dy;
                 if (distSq > 0.001F && distSq < kWormSeparationRadius * kWormSeparationRadius) {
                     const float dist = std::sqrt(distSq);
@@ -512,10 +611,10 @@ void EnemyManager::updateWorms(float dt, const ViewBounds& view) {
                 const float targetVX = delta.x * kWormMoveSpeed;
                 const float targetVY = delta.y * kWormMoveSpeed;
                 const float blend = std::clamp(kWormTurnRate * dt, 0.0F, 1.0F);
-                worm.velocity.x = worm.velocity.x + (targetVX - worm.velocity.x) * blend;
-                worm.velocity.y = worm.velocity.y + (targetVY - worm.velocity.y) * blend;
+                velocity.x = velocity.x + (targetVX - velocity.x) * blend;
+                velocity.y = velocity.y + (targetVY - velocity.y) * blend;
             } else if (!overlappingPlayer) {
-                worm.velocity = {0.0F, 0.0F};
+                velocity = {0.0F, 0.0F};
             }
         }
 
@@ -534,8 +633,8 @@ void EnemyManager::updateWorms(float dt, const ViewBounds& view) {
         }
 
         if (worm.airTimer <= 0.0F && worm.lungeCooldown <= 0.0F && inSolid) {
-            const entities::Vec2 toPlayer{player_.position().x - worm.position.x,
-                                          player_.position().y - worm.position.y};
+            const entities::Vec2 toPlayer{player_.position().x - position.x,
+                                          player_.position().y - position.y};
             const float dist = std::sqrt(toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y);
             if (dist < kWormLungeRange || edgeAhead) {
                 const float dirX = (dist > 0.01F) ? (toPlayer.x / dist) : (hasDesiredDir ? desiredDir.x : 1.0F);
@@ -544,36 +643,58 @@ void EnemyManager::updateWorms(float dt, const ViewBounds& view) {
                 const float len = std::sqrt(dirX * dirX + dirY * dirY);
                 const float normX = (len > 0.01F) ? (dirX / len) : dirX;
                 const float normY = (len > 0.01F) ? (dirY / len) : dirY;
-                worm.velocity.x = normX * kWormLungeSpeed;
-                worm.velocity.y = normY * kWormLungeSpeed;
+                velocity.x = normX * kWormLungeSpeed;
+                velocity.y = normY * kWormLungeSpeed;
                 worm.airTimer = kWormAirTime;
                 worm.lungeCooldown = kWormLungeCooldown;
             }
         }
 
-        worm.position.x += worm.velocity.x * dt;
-        worm.position.y += worm.velocity.y * dt;
-        worm.position.x = std::clamp(worm.position.x, 0.5F, static_cast<float>(world_.width() - 1));
-        worm.position.y = std::clamp(worm.position.y, 2.0F, static_cast<float>(world_.height() - 2));
+        worms_.body[i] = bodies.add(position,
+                                    velocity,
+                                    entities::kWormRadius,
+                                    entities::kWormRadius * 2.0F,
+                                    gravity,
+                                    0,
+                                    wormBounds);
+    }
+}
 
-        const int tileX = static_cast<int>(std::floor(worm.position.x));
-        int tileY = static_cast<int>(std::floor(worm.position.y));
+void EnemyManager::resolveWorms(const BodyStore& bodies) {
+    for (std::size_t i = 0; i < worms_.size(); ++i) {
+        auto& worm = worms_.state[i];
+        entities::Vec2& position = worms_.position[i];
+        entities::Vec2& velocity = worms_.velocity[i];
+        if (worms_.body[i] == kNoBody) {
+            continue;
+        }
+        position = bodies.position(worms_.body[i]);
+        velocity = bodies.velocity(worms_.body[i]);
+
+        const int tileX = static_cast<int>(std::floor(position.x));
+        int tileY = static_cast<int>(std::floor(position.y));
         const bool inSolidNow = physics_.isSolidTile(tileX, tileY);
         if (worm.airTimer <= 0.0F && !inSolidNow) {
             worm.airTimer = 0.1F;
         } else if (worm.airTimer <= 0.0F) {
             int adjustSteps = 0;
             while (adjustSteps < 6 && !physics_.isSolidTile(tileX, tileY)) {
-                worm.position.y = std::min(worm.position.y + kWormRecenterSpeed, static_cast<float>(world_.height() - 2));
-                tileY = static_cast<int>(std::floor(worm.position.y));
+                position.y = std::min(position.y + kWormRecenterSpeed, static_cast<float>(world_.height() - 2));
+                tileY = static_cast<int>(std::floor(position.y));
                 adjustSteps += 1;
             }
         }
 
+        const bool overlappingPlayer = physics_.aabbOverlap(position,
+                                                            entities::kWormRadius,
+                                                            entities::kWormRadius * 2.0F,
+                                                            player_.position(),
+                                                            entities::kPlayerHalfWidth,
+                                                            entities::kPlayerHeight);
         if (overlappingPlayer && worm.attackCooldown <= 0.0F) {
             const int dealt = player_.applyDamage(kWormDamage);
             damageNumbers_.addDamage(player_.position(), dealt, true);
-            const float dir = (player_.position().x < worm.position.x) ? -1.0F : 1.0F;
+            const float dir = (player_.position().x < position.x) ? -1.0F : 1.0F;
             entities::Vec2 knock = player_.velocity();
             knock.x += dir * 8.0F;
             knock.y = -9.0F;
@@ -582,12 +703,11 @@ void EnemyManager::updateWorms(float dt, const ViewBounds& view) {
         }
     }
 
-    worms_.erase(
-        std::remove_if(worms_.begin(), worms_.end(), [](const entities::Worm& worm) { return !worm.alive(); }),
-        worms_.end());
+    worms_.removeDead();
 }
 
-void EnemyManager::updateDragon(float dt) {
+void EnemyManager::updateDragon(float dt, BodyStore& bodies) {
+    dragon_.body = kNoBody;
     if (!dragonActive_ || dragonDefeated_) {
         return;
     }
@@ -596,7 +716,7 @@ void EnemyManager::updateDragon(float dt) {
     }
     if (!dragon_.alive()) {
         if (!dragon_.droppedLoot) {
-            const int drop = std::uniform_int_distribution<int>(kDragonCoinMin, kDragonCoinMax)(rng_);
+            const int drop = std::uniform_int_distribution<int>(kDragonCoinMin, kDragonCoinMax)(lootRng_);
             player_.addToInventory(world::TileType::Coin, drop);
             damageNumbers_.addLoot(dragon_.position, drop);
             dragon_.droppedLoot = true;
@@ -645,14 +765,24 @@ void EnemyManager::updateDragon(float dt) {
         }
     }
 
-    dragon_.position.x += dragon_.velocity.x * dt;
-    dragon_.position.y += dragon_.velocity.y * dt;
-    const float minX = dragonDenCenter_.x - dragonDenRadiusX_ + entities::kDragonHalfWidth;
-    const float maxX = dragonDenCenter_.x + dragonDenRadiusX_ - entities::kDragonHalfWidth;
-    const float minY = dragonDenCenter_.y - dragonDenRadiusY_ + entities::kDragonHeight;
-    const float maxY = dragonDenCenter_.y + dragonDenRadiusY_ - 0.4F;
-    dragon_.position.x = std::clamp(dragon_.position.x, minX, maxX);
-    dragon_.position.y = std::clamp(dragon_.position.y, minY, maxY);
+    const BodyBounds den{dragonDenCenter_.x - dragonDenRadiusX_ + entities::kDragonHalfWidth,
+                         dragonDenCenter_.y - dragonDenRadiusY_ + entities::kDragonHeight,
+                         dragonDenCenter_.x + dragonDenRadiusX_ - entities::kDragonHalfWidth,
+                         dragonDenCenter_.y + dragonDenRadiusY_ - 0.4F};
+    dragon_.body = bodies.add(dragon_.position,
+                              dragon_.velocity,
+                              entities::kDragonHalfWidth,
+                              entities::kDragonHeight,
+                              0.0F,
+                              0,
+                              den);
+}
+
+void EnemyManager::resolveDragon(const BodyStore& bodies) {
+    if (dragon_.body == kNoBody) {
+        return;
+    }
+    dragon_.position = bodies.position(dragon_.body);
 
     if (dragon_.chargeCooldown <= 0.0F && dragon_.chargeTimer <= 0.0F) {
         entities::Vec2 dir{player_.position().x - dragon_.position.x,
@@ -674,13 +804,13 @@ void EnemyManager::updateDragon(float dt) {
         dragon_.breathTick = 0.0F;
         dragon_.fireCooldown = kDragonFireInterval;
     }
+    const float headOffset = entities::kDragonHeight * kDragonSegmentGapFactor
+        * (static_cast<float>(kDragonSegments - 1) * 0.5F);
+    const float forwardOffset = entities::kDragonHeight * 0.3F;
+    const entities::Vec2 headPos{dragon_.position.x + dragon_.facing * (headOffset + forwardOffset),
+                                 dragon_.position.y - entities::kDragonHeight * kDragonSegmentYFactor
+                                     + entities::kDragonHeight * (kDragonHeadYOffsetFactor + 0.05F)};
     if (dragon_.breathTimer > 0.0F && dragon_.breathTick <= 0.0F) {
-        const float headOffset = entities::kDragonHeight * kDragonSegmentGapFactor
-            * (static_cast<float>(kDragonSegments - 1) * 0.5F);
-        const float forwardOffset = entities::kDragonHeight * 0.3F;
-        const entities::Vec2 headPos{dragon_.position.x + dragon_.facing * (headOffset + forwardOffset),
-                                     dragon_.position.y - entities::kDragonHeight * kDragonSegmentYFactor
-                                         + entities::kDragonHeight * (kDragonHeadYOffsetFactor + 0.05F)};
         entities::Vec2 dir{player_.position().x - headPos.x,
                            player_.position().y - headPos.y};
         const float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
@@ -691,7 +821,7 @@ void EnemyManager::updateDragon(float dt) {
             dir = {dragon_.facing, 0.0F};
         }
         std::uniform_real_distribution<float> spreadDist(-kDragonBreathSpread, kDragonBreathSpread);
-        const float spread = spreadDist(rng_);
+        const float spread = spreadDist(attackRng_);
         const float angle = std::atan2(dir.y, dir.x) + spread;
         EnemyProjectile projectile{};
         projectile.position = headPos;
@@ -701,17 +831,13 @@ void EnemyManager::updateDragon(float dt) {
         projectile.damage = kDragonProjectileDamage;
         projectile.isFlame = true;
         projectile.fromDragon = true;
+        projectile.previousPosition = projectile.position;
         enemyProjectiles_.push_back(projectile);
         dragon_.breathTick = kDragonBreathTick;
     }
 
-    if (dragon_.volleyCooldown <= 0.0F) {
-        const float headOffset = entities::kDragonHeight * kDragonSegmentGapFactor
-            * (static_cast<float>(kDragonSegments - 1) * 0.5F);
-        const float forwardOffset = entities::kDragonHeight * 0.3F;
-        const entities::Vec2 headPos{dragon_.position.x + dragon_.facing * (headOffset + forwardOffset),
-                                     dragon_.position.y - entities::kDragonHeight * kDragonSegmentYFactor
-                                         + entities::kDragonHeight * (kDragonHeadYOffsetFactor + 0.05F)};
+    const entities::Vec2 playerCenter{player_.position().x, player_.position().y - entities::kPlayerHeight * 0.5F};
+    if (dragon_.volleyCooldown <= 0.0F && physics_.lineOfSight(headPos, playerCenter)) {
         entities::Vec2 dir{player_.position().x - headPos.x,
                            player_.position().y - headPos.y};
         const float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
@@ -733,6 +859,7 @@ void EnemyManager::updateDragon(float dt) {
             projectile.damage = kDragonVolleyDamage;
             projectile.isFlame = false;
             projectile.fromDragon = true;
+            projectile.previousPosition = projectile.position;
             enemyProjectiles_.push_back(projectile);
         }
         dragon_.volleyCooldown = kDragonVolleyInterval;
@@ -756,34 +883,53 @@ void EnemyManager::updateDragon(float dt) {
     }
 }
 
-void EnemyManager::updateEnemyProjectiles(float dt) {
+void EnemyManager::updateEnemyProjectiles(float dt, BodyStore& bodies) {
     for (auto& projectile : enemyProjectiles_) {
+        projectile.body = kNoBody;
         projectile.lifetime -= dt;
         if (projectile.lifetime <= 0.0F) {
             continue;
         }
-        projectile.position.x += projectile.velocity.x * dt;
-        projectile.position.y += projectile.velocity.y * dt;
-        if (projectile.position.x < 0.0F || projectile.position.y < 0.0F
-            || projectile.position.x >= static_cast<float>(world_.width())
-            || projectile.position.y >= static_cast<float>(world_.height())
-            || physics_.solidAtPosition(projectile.position)) {
-            projectile.lifetime = 0.0F;
+        projectile.body = bodies.add(projectile.position, projectile.velocity, 0.0F, 0.0F, 0.0F, kBodyPoint);
+    }
+}
+
+void EnemyManager::resolveEnemyProjectiles(const BodyStore& bodies) {
+    for (auto& projectile : enemyProjectiles_) {
+        if (projectile.body == kNoBody || projectile.lifetime <= 0.0F) {
             continue;
         }
-        if (physics_.aabbOverlap(projectile.position,
-                                 projectile.radius,
-                                 projectile.radius * 2.0F,
-                                 player_.position(),
-                                 entities::kPlayerHalfWidth,
-                                 entities::kPlayerHeight)) {
-            const int dealt = player_.applyDamage(projectile.damage);
-            damageNumbers_.addDamage(player_.position(), dealt, true);
-            const float dir = (projectile.velocity.x < 0.0F) ? -1.0F : 1.0F;
-            entities::Vec2 knock = player_.velocity();
-            knock.x += dir * 5.5F;
-            knock.y = -6.0F;
-            player_.setVelocity(knock);
+        // The body already stopped at any wall; substeps only check the player along its path.
+        const entities::Vec2 end = bodies.position(projectile.body);
+        const entities::Vec2 path{end.x - projectile.position.x, end.y - projectile.position.y};
+        const int steps = PhysicsSystem::SubstepsFor(path);
+        const entities::Vec2 step{path.x / static_cast<float>(steps), path.y / static_cast<float>(steps)};
+        for (int i = 0; i < steps && projectile.lifetime > 0.0F; ++i) {
+            projectile.position.x += step.x;
+            projectile.position.y += step.y;
+            if (projectile.position.x < 0.0F || projectile.position.y < 0.0F
+                || projectile.position.x >= static_cast<float>(world_.width())
+                || projectile.position.y >= static_cast<float>(world_.height())) {
+                projectile.lifetime = 0.0F;
+                break;
+            }
+            if (physics_.aabbOverlap(projectile.position,
+                                     projectile.radius,
+                                     projectile.radius * 2.0F,
+                                     player_.position(),
+                                     entities::kPlayerHalfWidth,
+                                     entities::kPlayerHeight)) {
+                const int dealt = player_.applyDamage(projectile.damage);
+                damageNumbers_.addDamage(player_.position(), dealt, true);
+                const float dir = (projectile.velocity.x < 0.0F) ? -1.0F : 1.0F;
+                entities::Vec2 knock = player_.velocity();
+                knock.x += dir * 5.5F;
+                knock.y = -6.0F;
+                player_.setVelocity(knock);
+                projectile.lifetime = 0.0F;
+            }
+        }
+        if (bodies.has(projectile.body, kBodyHitWall)) {
             projectile.lifetime = 0.0F;
         }
     }
@@ -802,7 +948,7 @@ void EnemyManager::spawnZombie(const ViewBounds& view) {
 
     std::uniform_int_distribution<int> sideDist(0, 1);
     const int margin = 6;
-    int column = (sideDist(rng_) == 0) ? (view.startX - margin) : (view.startX + view.tilesWide + margin);
+    int column = (sideDist(spawnRng_) == 0) ? (view.startX - margin) : (view.startX + view.tilesWide + margin);
     column = std::clamp(column, 1, world_.width() - 2);
 
     int ground = -1;
@@ -817,28 +963,17 @@ void EnemyManager::spawnZombie(const ViewBounds& view) {
     }
 
     const int spawnY = ground - 1;
-    entities::Zombie zombie;
-    zombie.position = {static_cast<float>(column) + 0.5F, static_cast<float>(spawnY)};
-    zombie.velocity = {0.0F, 0.0F};
-    zombie.onGround = false;
-    zombie.id = nextZombieId_++;
-    zombie.lastX = zombie.position.x;
-    zombie.health = zombie.maxHealth;
-    zombie.attackCooldown = 0.0F;
-    zombie.jumpCooldown = 0.0F;
-    zombie.stuckTimer = 0.0F;
-    zombie.pathTimer = 0.0F;
-    zombie.desiredDir = 0;
-    zombie.lungeCooldown = 0.0F;
-    zombie.lungeTimer = 0.0F;
-    zombie.knockbackTimer = 0.0F;
-    zombie.knockbackVelocity = 0.0F;
-
-    if (physics_.collidesAabb(zombie.position, entities::kZombieHalfWidth, entities::kZombieHeight)) {
-        return;
-    }
+    spawnZombieAt({static_cast<float>(column) + 0.5F, static_cast<float>(spawnY)});
+}
 
-    zombies_.push_back(zombie);
+bool EnemyManager::spawnZombieAt(const entities::Vec2& feet) {
+    if (physics_.collidesAabb(feet, entities::kZombieHalfWidth, entities::kZombieHeight)) {
+        return false;
+    }
+    entities::Zombie zombie;
+    zombie.lastX = feet.x;
+    zombies_.add(feet, entities::kZombieMaxHealth, nextZombieId_++, zombie);
+    return true;
 }
 
 void EnemyManager::spawnFlyer(const ViewBounds& view) {
@@ -848,7 +983,7 @@ void EnemyManager::spawnFlyer(const ViewBounds& view) {
 
     std::uniform_int_distribution<int> sideDist(0, 1);
     const int margin = 6;
-    int column = (sideDist(rng_) == 0) ? (view.startX - margin) : (view.startX + view.tilesWide + margin);
+    int column = (sideDist(spawnRng_) == 0) ? (view.startX - margin) : (view.startX + view.tilesWide + margin);
     column = std::clamp(column, 1, world_.width() - 2);
 
     int ground = -1;
@@ -863,18 +998,15 @@ void EnemyManager::spawnFlyer(const ViewBounds& view) {
     }
 
     const float spawnY = static_cast<float>(std::max(2, ground - 6));
-    entities::FlyingEnemy enemy;
-    enemy.position = {static_cast<float>(column) + 0.5F, spawnY};
-    enemy.velocity = {0.0F, 0.0F};
-    enemy.id = nextFlyerId_++;
-    enemy.health = enemy.maxHealth;
-    enemy.attackCooldown = 0.0F;
-
-    if (physics_.solidAtPosition(enemy.position)) {
-        return;
-    }
+    spawnFlyerAt({static_cast<float>(column) + 0.5F, spawnY});
+}
 
-    flyers_.push_back(enemy);
+bool EnemyManager::spawnFlyerAt(const entities::Vec2& position) {
+    if (physics_.solidAtPosition(position)) {
+        return false;
+    }
+    flyers_.add(position, entities::kFlyingEnemyMaxHealth, nextFlyerId_++, entities::FlyingEnemy{});
+    return true;
 }
 
 void EnemyManager::spawnWorm(const ViewBounds& view) {
@@ -884,38 +1016,37 @@ void EnemyManager::spawnWorm(const ViewBounds& view) {
 
     std::uniform_int_distribution<int> sideDist(0, 1);
     const int margin = 8;
-    int column = (sideDist(rng_) == 0) ? (view.startX - margin) : (view.startX + view.tilesWide + margin);
+    int column = (sideDist(spawnRng_) == 0) ? (view.startX - margin) : (view.startX + view.tilesWide + margin);
     column = std::clamp(column, 1, world_.width() - 2);
 
     const float minDepth = static_cast<float>(world_.height()) * kWormSpawnDepthRatio;
-    const float baseY = std::clamp(player_.position().y + std::uniform_real_distribution<float>(-4.0F, 6.0F)(rng_),
+    const float baseY = std::clamp(player_.position().y + std::uniform_real_distribution<float>(-4.0F, 6.0F)(spawnRng_),
                                    minDepth,
                                    static_cast<float>(world_.height() - 2));
-    entities::Worm worm;
-    worm.position = {static_cast<float>(column) + 0.5F, baseY};
-    worm.velocity = {0.0F, 0.0F};
-    worm.id = nextWormId_++;
-    worm.health = worm.maxHealth;
-    worm.attackCooldown = 0.0F;
-
-    int tileX = static_cast<int>(std::floor(worm.position.x));
-    int tileY = static_cast<int>(std::floor(worm.position.y));
+    entities::Vec2 position{static_cast<float>(column) + 0.5F, baseY};
+    const int tileX = static_cast<int>(std::floor(position.x));
+    int tileY = static_cast<int>(std::floor(position.y));
     int search = 0;
     while (search < 8 && !physics_.isSolidTile(tileX, tileY)) {
-        worm.position.y = std::min(worm.position.y + 1.0F, static_cast<float>(world_.height() - 2));
-        tileY = static_cast<int>(std::floor(worm.position.y));
+        position.y = std::min(position.y + 1.0F, static_cast<float>(world_.height() - 2));
+        tileY = static_cast<int>(std::floor(position.y));
         search += 1;
     }
-    if (!physics_.isSolidTile(tileX, tileY)) {
-        return;
-    }
+    spawnWormAt(position);
+}
 
-    worms_.push_back(worm);
+bool EnemyManager::spawnWormAt(const entities::Vec2& position) {
+    if (!physics_.solidAtPosition(position)) {
+        return false;
+    }
+    worms_.add(position, entities::kWormMaxHealth, nextWormId_++, entities::Worm{});
+    return true;
 }
 
 void EnemyManager::spawnDragon() {
     dragon_ = {};
     dragon_.position = dragonDenCenter_;
+    dragon_.previousPosition = dragon_.position;
     dragon_.velocity = {0.0F, 0.0F};
     dragon_.health = dragon_.maxHealth;
     dragon_.attackCooldown = 0.0F;
@@ -932,71 +1063,11 @@ void EnemyManager::spawnDragon() {
     dragonSpawned_ = true;
 }
 
-bool EnemyManager::isWalkableSpot(int x, int footY) const {
-    if (x < 0 || x >= world_.width()) {
-        return false;
-    }
-    if (footY < 2 || footY >= world_.height()) {
-        return false;
-    }
-    if (!physics_.isSolidTile(x, footY)) {
-        return false;
-    }
-    if (physics_.isSolidTile(x, footY - 1) || physics_.isSolidTile(x, footY - 2)) {
-        return false;
-    }
-    return true;
-}
-
-bool EnemyManager::pathClear(int startX, int endX, int footY) const {
-    if (startX == endX) {
-        return true;
-    }
-    const int step = (endX < startX) ? -1 : 1;
-    for (int x = startX; x != endX; x += step) {
-        if (physics_.isSolidTile(x, footY - 1) || physics_.isSolidTile(x, footY - 2)) {
-            return false;
-        }
-    }
-    return true;
-}
-
-int EnemyManager::computeZombiePathDirection(const entities::Zombie& zombie) const {
-    const int startX = static_cast<int>(std::floor(zombie.position.x));
-    const int footY = static_cast<int>(std::floor(zombie.position.y));
-    const float playerX = player_.position().x;
-    const int directDir = (playerX < zombie.position.x) ? -1 : 1;
-    const int targetX = static_cast<int>(std::floor(playerX));
-    if (pathClear(startX, targetX, footY)) {
-        return directDir;
-    }
-
-    constexpr int kScanRange = 14;
-    int bestDir = directDir;
-    float bestScore = std::numeric_limits<float>::infinity();
-    for (int offset = 1; offset <= kScanRange; ++offset) {
-        const int leftX = startX - offset;
-        if (leftX >= 0 && pathClear(startX, leftX, footY) && isWalkableSpot(leftX, footY)) {
-            const float score = std::fabs(static_cast<float>(leftX) - playerX);
-            if (score < bestScore) {
-                bestScore = score;
-                bestDir = -1;
-            }
-        }
-        const int rightX = startX + offset;
-        if (rightX < world_.width() && pathClear(startX, rightX, footY) && isWalkableSpot(rightX, footY)) {
-            const float score = std::fabs(static_cast<float>(rightX) - playerX);
-            if (score < bestScore) {
-                bestScore = score;
-                bestDir = 1;
-            }
-        }
-    }
-    return bestDir;
-}
-
-void EnemyManager::applyZombiePhysics(entities::Zombie& zombie, float dt) {
-    const float horizontalDelta = std::fabs(zombie.position.x - zombie.lastX);
+void EnemyManager::steerZombie(std::size_t index, float dt) {
+    auto& zombie = zombies_.state[index];
+    const entities::Vec2& position = zombies_.position[index];
+    entities::Vec2& velocity = zombies_.velocity[index];
+    const float horizontalDelta = std::fabs(position.x - zombie.lastX);
     if (horizontalDelta < 0.02F) {
         zombie.stuckTimer += dt;
     } else {
@@ -1006,22 +1077,22 @@ void EnemyManager::applyZombiePhysics(entities::Zombie& zombie, float dt) {
 
     int desiredDir = zombie.desiredDir;
     if (desiredDir == 0) {
-        desiredDir = (player_.position().x < zombie.position.x) ? -1 : 1;
+        desiredDir = (player_.position().x < position.x) ? -1 : 1;
     }
     float direction = static_cast<float>(desiredDir);
 
     if (zombie.knockbackTimer > 0.0F) {
-        zombie.velocity.x = zombie.knockbackVelocity;
+        velocity.x = zombie.knockbackVelocity;
         zombie.knockbackVelocity *= 0.88F;
         zombie.knockbackTimer = std::max(0.0F, zombie.knockbackTimer - dt);
     } else if (zombie.lungeTimer > 0.0F) {
-        zombie.velocity.x = direction * kZombieMoveSpeed * 2.2F;
+        velocity.x = direction * kZombieMoveSpeed * 2.2F;
     } else {
-        zombie.velocity.x = direction * kZombieMoveSpeed;
+        velocity.x = direction * kZombieMoveSpeed;
     }
 
-    const int aheadX = static_cast<int>(std::floor(zombie.position.x + direction * (entities::kZombieHalfWidth + 0.2F)));
-    const int footY = static_cast<int>(std::floor(zombie.position.y));
+    const int aheadX = static_cast<int>(std::floor(position.x + direction * (entities::kZombieHalfWidth + 0.2F)));
+    const int footY = static_cast<int>(std::floor(position.y));
     bool obstacle = false;
     for (int y = footY - 1; y <= footY; ++y) {
         if (physics_.isSolidTile(aheadX, y)) {
@@ -1032,7 +1103,7 @@ void EnemyManager::applyZombiePhysics(entities::Zombie& zombie, float dt) {
 
     if (zombie.onGround && zombie.jumpCooldown <= 0.0F) {
         if (obstacle) {
-            zombie.velocity.y = -kZombieJumpVelocity * 0.95F;
+            velocity.y = -kZombieJumpVelocity * 0.95F;
             zombie.onGround = false;
             zombie.jumpCooldown = 0.9F;
         }
@@ -1041,37 +1112,92 @@ void EnemyManager::applyZombiePhysics(entities::Zombie& zombie, float dt) {
     if (zombie.stuckTimer > 1.5F && zombie.onGround) {
         zombie.stuckTimer = 0.0F;
     }
+}
 
-    zombie.velocity.y += kGravity * dt;
+void EnemyManager::storePreviousPositions() {
+    zombies_.previousPosition = zombies_.position;
+    flyers_.previousPosition = flyers_.position;
+    worms_.previousPosition = worms_.position;
+    for (auto& projectile : enemyProjectiles_) {
+        projectile.previousPosition = projectile.position;
+    }
+    dragon_.previousPosition = dragon_.position;
+}
 
-    entities::Vec2 position = zombie.position;
-    position.x += zombie.velocity.x * dt;
-    physics_.resolveHorizontalAabb(position, zombie.velocity, entities::kZombieHalfWidth, entities::kZombieHeight);
+void EnemyManager::hashState(StateHasher& hasher) const {
+    hasher.add(static_cast<std::uint64_t>(zombies_.size()));
+    for (std::size_t i = 0; i < zombies_.size(); ++i) {
+        hasher.add(zombies_.id[i]);
+        hasher.add(zombies_.health[i]);
+        hasher.add(zombies_.position[i]);
+        hasher.add(zombies_.velocity[i]);
+    }
+    hasher.add(static_cast<std::uint64_t>(flyers_.size()));
+    for (std::size_t i = 0; i < flyers_.size(); ++i) {
+        hasher.add(flyers_.id[i]);
+        hasher.add(flyers_.health[i]);
+        hasher.add(flyers_.position[i]);
+        hasher.add(flyers_.velocity[i]);
+    }
+    hasher.add(static_cast<std::uint64_t>(worms_.size()));
+    for (std::size_t i = 0; i < worms_.size(); ++i) {
+        hasher.add(worms_.id[i]);
+        hasher.add(worms_.health[i]);
+        hasher.add(worms_.position[i]);
+        hasher.add(worms_.velocity[i]);
+    }
+    hasher.add(dragon_.health);
+    hasher.add(dragon_.position);
+    hasher.add(dragon_.velocity);
+    hasher.add(static_cast<std::uint64_t>(enemyProjectiles_.size()));
+    for (const auto& projectile : enemyProjectiles_) {
+        hasher.add(projectile.position);
+        hasher.add(projectile.velocity);
+        hasher.add(projectile.lifetime);
+    }
+    hasher.add(spawnTimerZombies_);
+    hasher.add(spawnTimerFlyers_);
+    hasher.add(spawnTimerWorms_);
+}
 
-    position.y += zombie.velocity.y * dt;
-    physics_.resolveVerticalAabb(position, zombie.velocity, entities::kZombieHalfWidth, entities::kZombieHeight, zombie.onGround);
+std::size_t EnemyManager::enemyCount() const {
+    const std::size_t dragon = dragonActive_ && dragon_.alive() ? 1 : 0;
+    return zombies_.size() + flyers_.size() + worms_.size() + dragon;
+}
 
-    const float maxX = static_cast<float>(world_.width() - 1);
-    const float maxY = static_cast<float>(world_.height() - 1);
-    position.x = std::clamp(position.x, 0.0F, maxX);
-    position.y = std::clamp(position.y, 0.0F, maxY);
-    zombie.position = position;
-    zombie.lastX = zombie.position.x;
+bool EnemyManager::nearView(const entities::Vec2& position) const {
+    const float margin = 4.0F;
+    return position.x >= static_cast<float>(view_.startX) - margin
+        && position.x <= static_cast<float>(view_.startX + view_.tilesWide) + margin
+        && position.y >= static_cast<float>(view_.startY) - margin
+        && position.y <= static_cast<float>(view_.startY + view_.tilesTall) + margin;
 }
 
-void EnemyManager::fillHud(rendering::HudState& hud) const {
-    const int enemyCount = std::min(static_cast<int>(flyers_.size()), rendering::kMaxFlyingEnemies);
-    hud.flyingEnemyCount = enemyCount;
-    for (int i = 0; i < enemyCount; ++i) {
-        const auto& enemy = flyers_[static_cast<std::size_t>(i)];
-        auto& entry = hud.flyingEnemies[static_cast<std::size_t>(i)];
-        entry.active = enemy.alive();
-        entry.x = enemy.position.x;
-        entry.y = enemy.position.y;
+void EnemyManager::fillHud(rendering::HudState& hud, float alpha) const {
+    hud.zombies.clear();
+    for (std::size_t i = 0; i < zombies_.size(); ++i) {
+        if (zombies_.alive(i) && nearView(zombies_.position[i])) {
+            const entities::Vec2 position =
+                entities::Interpolate(zombies_.previousPosition[i], zombies_.position[i], alpha);
+            hud.zombies.push_back({position.x, position.y, zombies_.health[i], entities::kZombieMaxHealth});
+        }
+    }
+
+    int enemyCount = 0;
+    for (std::size_t i = 0; i < flyers_.size() && enemyCount < rendering::kMaxFlyingEnemies; ++i) {
+        if (!nearView(flyers_.position[i])) {
+            continue;
+        }
+        auto& entry = hud.flyingEnemies[static_cast<std::size_t>(enemyCount++)];
+        const entities::Vec2 position = entities::Interpolate(flyers_.previousPosition[i], flyers_.position[i], alpha);
+        entry.active = flyers_.alive(i);
+        entry.x = position.x;
+        entry.y = position.y;
         entry.radius = entities::kFlyingEnemyRadius;
-        entry.health = enemy.health;
-        entry.maxHealth = enemy.maxHealth;
+        entry.health = flyers_.health[i];
+        entry.maxHealth = entities::kFlyingEnemyMaxHealth;
     }
+    hud.flyingEnemyCount = enemyCount;
     for (int i = enemyCount; i < rendering::kMaxFlyingEnemies; ++i) {
         hud.flyingEnemies[static_cast<std::size_t>(i)] = {};
     }
@@ -1081,9 +1207,10 @@ void EnemyManager::fillHud(rendering::HudState& hud) const {
     for (int i = 0; i < projectileCount; ++i) {
         const auto& projectile = enemyProjectiles_[static_cast<std::size_t>(i)];
         auto& entry = hud.enemyProjectiles[static_cast<std::size_t>(i)];
+        const entities::Vec2 position = entities::Interpolate(projectile.previousPosition, projectile.position, alpha);
         entry.active = projectile.lifetime > 0.0F;
-        entry.x = projectile.position.x;
-        entry.y = projectile.position.y;
+        entry.x = position.x;
+        entry.y = position.y;
         entry.radius = projectile.radius;
         entry.isFlame = projectile.isFlame;
     }
@@ -1091,28 +1218,32 @@ void EnemyManager::fillHud(rendering::HudState& hud) const {
         hud.enemyProjectiles[static_cast<std::size_t>(i)] = {};
     }
 
-    const int wormCount = std::min(static_cast<int>(worms_.size()), rendering::kMaxWorms);
-    hud.wormCount = wormCount;
-    for (int i = 0; i < wormCount; ++i) {
-        const auto& worm = worms_[static_cast<std::size_t>(i)];
-        auto& entry = hud.worms[static_cast<std::size_t>(i)];
-        entry.active = worm.alive();
-        entry.x = worm.position.x;
-        entry.y = worm.position.y;
-        entry.vx = worm.velocity.x;
-        entry.vy = worm.velocity.y;
+    int wormCount = 0;
+    for (std::size_t i = 0; i < worms_.size() && wormCount < rendering::kMaxWorms; ++i) {
+        if (!nearView(worms_.position[i])) {
+            continue;
+        }
+        auto& entry = hud.worms[static_cast<std::size_t>(wormCount++)];
+        const entities::Vec2 position = entities::Interpolate(worms_.previousPosition[i], worms_.position[i], alpha);
+        entry.active = worms_.alive(i);
+        entry.x = position.x;
+        entry.y = position.y;
+        entry.vx = worms_.velocity[i].x;
+        entry.vy = worms_.velocity[i].y;
         entry.radius = entities::kWormRadius;
-        entry.health = worm.health;
-        entry.maxHealth = worm.maxHealth;
+        entry.health = worms_.health[i];
+        entry.maxHealth = entities::kWormMaxHealth;
     }
+    hud.wormCount = wormCount;
     for (int i = wormCount; i < rendering::kMaxWorms; ++i) {
         hud.worms[static_cast<std::size_t>(i)] = {};
     }
 
     hud.dragon.active = dragonActive_ && dragon_.alive();
     if (hud.dragon.active) {
-        hud.dragon.x = dragon_.position.x;
-        hud.dragon.y = dragon_.position.y;
+        const entities::Vec2 position = entities::Interpolate(dragon_.previousPosition, dragon_.position, alpha);
+        hud.dragon.x = position.x;
+        hud.dragon.y = position.y;
         hud.dragon.halfWidth = entities::kDragonHalfWidth;
         hud.dragon.height = entities::kDragonHeight;
         hud.dragon.wingPhase = swoopTimer_ * 3.0F;
@@ -0,0 +1,199 @@
+#include "terraria/game/FlowField.h"
+
+#include "terraria/core/Trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace terraria::game {
+
+namespace {
+constexpr int kWalkCost = 2;
+constexpr int kClimbCostPerRow = 3;
+constexpr int kDropCostPerRow = 1;
+} // namespace
+
+FlowField::FlowField(const world::World& world, const PhysicsSystem& physics)
+    : world_{world},
+      physics_{physics} {}
+
+void FlowField::clear() {
+    valid_ = false;
+    chunkHashes_.clear();
+}
+
+void FlowField::update(const entities::Vec2& target) {
+    int x = 0;
+    int y = 0;
+    if (!findStandCell(target, x, y)) {
+        return;
+    }
+    if (valid_ && x == goalX_ && y == goalY_ && !chunksChanged()) {
+        return;
+    }
+    rebuild(x, y);
+}
+
+int FlowField::direction(const entities::Vec2& feet) const {
+    const int index = localIndex(feet);
+    return index < 0 ? 0 : step_[static_cast<std::size_t>(index)];
+}
+
+int FlowField::cost(const entities::Vec2& feet) const {
+    const int index = localIndex(feet);
+    if (index < 0 || cost_[static_cast<std::size_t>(index)] == kUnreached) {
+        return -1;
+    }
+    return cost_[static_cast<std::size_t>(index)];
+}
+
+int FlowField::localIndex(const entities::Vec2& feet) const {
+    int x = 0;
+    int y = 0;
+    if (!valid_ || !findStandCell(feet, x, y)) {
+        return -1;
+    }
+    const int localX = x - originX_;
+    const int localY = y - originY_;
+    if (localX < 0 || localX >= width_ || localY < 0 || localY >= height_) {
+        return -1;
+    }
+    return localY * width_ + localX;
+}
+
+// Airborne bodies use the floor they will land on.
+bool FlowField::findStandCell(const entities::Vec2& feet, int& x, int& y) const {
+    x = static_cast<int>(std::floor(feet.x));
+    const int top = static_cast<int>(std::floor(feet.y));
+    for (int row = top; row <= top + kMaxDrop; ++row) {
+        if (physics_.isSolidTile(x, row)) {
+            return false;
+        }
+        if (physics_.isSolidTile(x, row + 1)) {
+            y = row;
+            return !physics_.isSolidTile(x, row - 1);
+        }
+    }
+    return false;
+}
+
+bool FlowField::chunksChanged() const {
+    if (world_.chunksX() != chunksX_) {
+        return true;
+    }
+    std::size_t next = 0;
+    for (int cy = chunkY0_; cy <= chunkY1_; ++cy) {
+        for (int cx = chunkX0_; cx <= chunkX1_; ++cx) {
+            const auto chunk = static_cast<std::size_t>(cy) * static_cast<std::size_t>(chunksX_) + static_cast<std::size_t>(cx);
+            if (chunk >= world_.chunkCount() || world_.chunkHash(chunk) != chunkHashes_[next++]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool FlowField::solid(int localX, int localY) const {
+    if (localX < 0 || localX >= width_ || localY < 0 || localY >= height_) {
+        return true;
+    }
+    return solid_[static_cast<std::size_t>(localY * width_ + localX)] != 0;
+}
+
+bool FlowField::standable(int localX, int localY) const {
+    return localX >= 0 && localX < width_ && localY >= 1 && localY + 1 < height_ && !solid(localX, localY)
+        && !solid(localX, localY - 1) && solid(localX, localY + 1);
+}
+
+void FlowField::relax(int localX, int localY, int cost, std::int8_t step) {
+    const auto index = static_cast<std::size_t>(localY * width_ + localX);
+    if (cost >= cost_[index]) {
+        return;
+    }
+    cost_[index] = static_cast<std::uint16_t>(cost);
+    step_[index] = step;
+    open_.push_back(static_cast<std::uint64_t>(cost) << 32 | index);
+    std::push_heap(open_.begin(), open_.end(), std::greater<>{});
+}
+
+void FlowField::rebuild(int goalX, int goalY) {
+    TERRARIA_TRACE_ZONE("enemies.flowField");
+    goalX_ = goalX;
+    goalY_ = goalY;
+    originX_ = goalX - kRadiusX;
+    originY_ = goalY - kRadiusY;
+    width_ = kRadiusX * 2 + 1;
+    height_ = kRadiusY * 2 + 1;
+    const auto area = static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
+    solid_.resize(area);
+    for (int localY = 0; localY < height_; ++localY) {
+        for (int localX = 0; localX < width_; ++localX) {
+            solid_[static_cast<std::size_t>(localY * width_ + localX)] =
+                physics_.isSolidTile(originX_ + localX, originY_ + localY) ? 1 : 0;
+        }
+    }
+
+    chunksX_ = world_.chunksX();
+    const int size = world::World::kChunkSize;
+    chunkX0_ = std::max(originX_, 0) / size;
+    chunkY0_ = std::max(originY_, 0) / size;
+    chunkX1_ = std::min(originX_ + width_, world_.width()) - 1;
+    chunkY1_ = std::min(originY_ + height_, world_.height()) - 1;
+    chunkX1_ = chunkX1_ < 0 ? -1 : chunkX1_ / size;
+    chunkY1_ = chunkY1_ < 0 ? -1 : chunkY1_ / size;
+    chunkHashes_.clear();
+    for (int cy = chunkY0_; cy <= chunkY1_; ++cy) {
+        for (int cx = chunkX0_; cx <= chunkX1_; ++cx) {
+            chunkHashes_.push_back(
+                world_.chunkHash(static_cast<std::size_t>(cy) * static_cast<std::size_t>(chunksX_) + static_cast<std::size_t>(cx)));
+        }
+    }
+
+    // Backwards from the goal: each settled cell u relaxes the cells that can move into it.
+    cost_.assign(area, kUnreached);
+    step_.assign(area, 0);
+    open_.clear();
+    relax(kRadiusX, kRadiusY, 0, 0);
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), std::greater<>{});
+        const std::uint64_t entry = open_.back();
+        open_.pop_back();
+        const auto index = static_cast<int>(entry & 0xFFFFFFFFU);
+        const auto reached = static_cast<int>(entry >> 32);
+        if (reached != cost_[static_cast<std::size_t>(index)]) {
+            continue;
+        }
+        const int ux = index % width_;
+        const int uy = index / width_;
+        for (const int side : {-1, 1}) {
+            const int px = ux + side;
+            const auto step = static_cast<std::int8_t>(-side);
+            if (standable(px, uy)) {
+                relax(px, uy, reached + kWalkCost, step);
+            }
+            // Climbing k rows needs headroom above the start and a wall face to trigger the jump.
+            for (int k = 1; k <= kMaxClimb; ++k) {
+                if (solid(px, uy + k - 2)) {
+                    break;
+                }
+                if (standable(px, uy + k) && (solid(ux, uy + k) || solid(ux, uy + k - 1))) {
+                    relax(px, uy + k, reached + kWalkCost + k * kClimbCostPerRow, step);
+                }
+            }
+            // Dropping d rows needs the landing column clear from the start's head row down.
+            for (int d = 1; d <= kMaxDrop; ++d) {
+                if (solid(ux, uy - d - 1)) {
+                    break;
+                }
+                if (standable(px, uy - d)) {
+                    relax(px, uy - d, reached + kWalkCost + d * kDropCostPerRow, step);
+                }
+            }
+        }
+    }
+    valid_ = true;
+    ++rebuilds_;
+}
+
+} // namespace terraria::game
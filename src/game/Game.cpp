@@ -1,14 +1,21 @@
 #include "terraria/game/Game.h"
 
+#include "terraria/core/HeapStats.h"
+#include "terraria/core/JobSystem.h"
+#include "terraria/core/Trace.h"
+#include "terraria/input/InputRecording.h"
+
 #include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
 #include <cctype>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
 #include <sstream>
+#include <utility>
 
 namespace terraria::game {
 
@@ -31,6 +38,7 @@ constexpr float kDayLengthSeconds = 180.0F;
 constexpr float kNightStart = 0.55F;
 constexpr float kNightEnd = 0.95F;
 constexpr float kPerfSmoothing = 0.1F;
+constexpr float kMaxFrameSeconds = 0.25F;
 constexpr float kPi = 3.1415926535F;
 constexpr std::uint32_t kSeedSalt = 0x9E3779B9U;
 
@@ -85,6 +93,47 @@ std::uint32_t generateSeed() {
     return static_cast<std::uint32_t>((now ^ (now >> 32)) + kSeedSalt);
 }
 
+// Wall-clock seeds break replay, so deterministic runs draw every seed from the configured one.
+std::uint32_t sessionSeed(const core::AppConfig& config) {
+    return config.deterministic ? core::StreamSeed(config.simulationSeed, 0) : generateSeed();
+}
+
+std::unique_ptr<rendering::IRenderer> createRenderer(const core::AppConfig& config) {
+#ifdef TERRARIA_HEADLESS
+    (void)config;
+    return rendering::CreateNullRenderer();
+#else
+    return config.headless ? rendering::CreateNullRenderer() : rendering::CreateSdlRenderer(config);
+#endif
+}
+
+std::unique_ptr<input::IInputSystem> createDeviceInput(const core::AppConfig& config) {
+#ifdef TERRARIA_HEADLESS
+    (void)config;
+    return input::CreateNullInputSystem();
+#else
+    return config.headless ? input::CreateNullInputSystem() : input::CreateSdlInputSystem();
+#endif
+}
+
+std::unique_ptr<input::IInputSystem> createInputSystem(const core::AppConfig& config) {
+    if (!config.replayInputPath.empty()) {
+        return input::CreateReplayInputSystem(config.replayInputPath);
+    }
+    auto input = createDeviceInput(config);
+    if (config.recordInputPath.empty()) {
+        return input;
+    }
+    input::InputRecordingHeader header{};
+    header.simulationHz = static_cast<std::uint32_t>(std::max(1, config.simulationHz));
+    header.simulationSeed = config.simulationSeed;
+    header.worldWidth = config.worldWidth;
+    header.worldHeight = config.worldHeight;
+    header.windowWidth = config.windowWidth;
+    header.windowHeight = config.windowHeight;
+    return input::CreateRecordingInputSystem(std::move(input), config.recordInputPath, header);
+}
+
 void applyDefaultLoadout(entities::Player& player) {
     player.resetHealth();
     player.addTool(entities::ToolKind::Pickaxe, entities::ToolTier::Wood);
@@ -113,13 +162,30 @@ Game::Game(const core::AppConfig& config)
                     enemyManager_.worms(),
                     enemyManager_.dragon(),
                     enemyManager_},
-      renderer_{rendering::CreateSdlRenderer(config_)},
-      inputSystem_{input::CreateSdlInputSystem()},
+      renderer_{createRenderer(config_)},
+      inputSystem_{createInputSystem(config_)},
       inventorySystem_{config_, player_, *inputSystem_},
       craftingSystem_{config_, player_, *inputSystem_},
-      dayLength_{kDayLengthSeconds} {}
+      dayLength_{kDayLengthSeconds},
+      frameTimes_{config.perfWindowSeconds},
+      updateTimes_{config.perfWindowSeconds},
+      renderTimes_{config.perfWindowSeconds},
+      simulationStep_{1.0F / static_cast<float>(std::max(1, config.simulationHz))},
+      autosave_{saveManager_, config.autosaveIntervalSeconds},
+      worldLog_{config.editLogFlushMs},
+      playerLog_{config.editLogFlushMs} {}
 
 void Game::initialize() {
+    if (config_.deltaWorldSaves) {
+        saveManager_.setWorldEncoding(SaveManager::WorldEncoding::Delta);
+    } else if (config_.compressedWorldSaves) {
+        saveManager_.setWorldEncoding(SaveManager::WorldEncoding::Blocks);
+    }
+    core::SetTraceThreadName("main");
+    core::JobSystem::Shared().setTraceHooks({[](const char* name) { core::TraceBegin(name); }, core::TraceEnd});
+    if (config_.traceFrames > 0) {
+        core::StartTraceCapture(config_.traceFrames, config_.tracePath);
+    }
     renderer_->initialize();
     inputSystem_->initialize();
     loadOrCreateSaves();
@@ -127,37 +193,162 @@ void Game::initialize() {
     isNight_ = false;
     cameraPosition_ = clampCameraTarget({static_cast<float>(world_.width()) * 0.5F,
                                          static_cast<float>(world_.height()) * 0.5F});
+    if (config_.autoStartSession) {
+        WorldInfo world{};
+        world.id = "headless";
+        world.name = "Headless";
+        world.seed = sessionSeed(config_);
+        CharacterInfo character{};
+        character.id = "headless";
+        character.name = "Headless";
+        startSession(world, character);
+    }
 }
 
-bool Game::tick() {
+bool Game::tick(float frameSeconds) {
+    const std::uint64_t heapBefore = core::HeapAllocationCount();
     const auto frameStart = std::chrono::steady_clock::now();
-    const float dt = 1.0F / static_cast<float>(config_.targetFps);
-    handleInput();
-    const auto updateStart = std::chrono::steady_clock::now();
-    update(dt);
-    processActions(dt);
-    const auto updateEnd = std::chrono::steady_clock::now();
-    updateHudState();
-    const auto renderStart = std::chrono::steady_clock::now();
-    render();
-    const auto frameEnd = std::chrono::steady_clock::now();
-
-    const float frameMs = std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
-    const float updateMs = std::chrono::duration<float, std::milli>(updateEnd - updateStart).count();
-    const float renderMs = std::chrono::duration<float, std::milli>(frameEnd - renderStart).count();
+    systemTimes_ = {};
+    float updateMs = 0.0F;
+    float renderMs = 0.0F;
+    {
+        TERRARIA_TRACE_ZONE("frame");
+        // Deterministic runs advance exactly one step per frame so wall-clock jitter never reaches the simulation.
+        handleInput(config_.deterministic ? simulationStep_ : frameSeconds);
+        processInterfaceInput();
+        const auto updateStart = std::chrono::steady_clock::now();
+        if (config_.deterministic) {
+            stepSimulation();
+            renderAlpha_ = 1.0F;
+        } else {
+            accumulator_ += std::clamp(frameSeconds, 0.0F, kMaxFrameSeconds);
+            int steps = 0;
+            while (accumulator_ >= simulationStep_) {
+                if (steps >= std::max(1, config_.maxCatchUpSteps)) {
+                    // Too far behind after a stall: drop the backlog rather than spiral.
+                    accumulator_ = std::fmod(accumulator_, simulationStep_);
+                    break;
+                }
+                stepSimulation();
+                accumulator_ -= simulationStep_;
+                ++steps;
+            }
+            renderAlpha_ = std::clamp(accumulator_ / simulationStep_, 0.0F, 1.0F);
+        }
+        pollAutosave();
+        const auto updateEnd = std::chrono::steady_clock::now();
+        updateHudState();
+        const auto renderStart = std::chrono::steady_clock::now();
+        render();
+        const auto frameEnd = std::chrono::steady_clock::now();
+        updateMs = std::chrono::duration<float, std::milli>(updateEnd - updateStart).count();
+        renderMs = std::chrono::duration<float, std::milli>(frameEnd - renderStart).count();
+    }
+
+    const float workMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    const float frameMs = frameSeconds * 1000.0F;
     recordPerformanceMetrics(frameMs, updateMs, renderMs);
-    return !inputSystem_->shouldQuit() && !requestQuit_;
+    frameArena_.reset();
+    frameHeapAllocations_ = core::HeapAllocationCount() - heapBefore;
+    heapAllocationsSinceLog_ += frameHeapAllocations_;
+    if (config_.hitchThresholdMs > 0.0F && workMs > config_.hitchThresholdMs) {
+        logHitch(workMs, frameMs);
+    }
+    ++frameIndex_;
+    TERRARIA_TRACE_COUNTER("frame ms", frameMs);
+    TERRARIA_TRACE_COUNTER("heap allocs", frameHeapAllocations_);
+    TERRARIA_TRACE_COUNTER("enemies", enemyManager_.enemyCount());
+    finishTraceFrame();
+    if (config_.deterministic && config_.stateHashLogTicks > 0 && simulationTick_ != lastLoggedTick_
+        && simulationTick_ % static_cast<std::uint64_t>(config_.stateHashLogTicks) == 0) {
+        std::fprintf(stderr,
+                     "tick %llu state %016llx heap allocs %llu\n",
+                     static_cast<unsigned long long>(simulationTick_),
+                     static_cast<unsigned long long>(stateHash_),
+                     static_cast<unsigned long long>(heapAllocationsSinceLog_));
+        lastLoggedTick_ = simulationTick_;
+        heapAllocationsSinceLog_ = 0;
+    }
+    const bool ticksLeft = config_.maxTicks == 0 || simulationTick_ < config_.maxTicks;
+    return ticksLeft && !inputSystem_->shouldQuit() && !requestQuit_;
+}
+
+void Game::finishTraceFrame() {
+    std::string path;
+    bool written = false;
+    if (!core::EndTraceFrame(path, written)) {
+        return;
+    }
+    std::fprintf(stderr, written ? "trace written to %s\n" : "trace: could not write %s\n", path.c_str());
+    chatConsole_.addMessage(written ? "TRACE WRITTEN " + path : "TRACE WRITE FAILED", true);
+}
+
+void Game::logHitch(float workMs, float frameMs) {
+    ++hitchCount_;
+    if (!hitchLog_.is_open()) {
+        hitchLog_.open(config_.hitchLogPath, std::ios::app);
+        if (!hitchLog_) {
+            return;
+        }
+        hitchLog_ << "# session: frames over " << config_.hitchThresholdMs << " ms of work, system times in ms\n";
+    }
+    const SystemTimes& t = systemTimes_;
+    char line[320];
+    std::snprintf(line,
+                  sizeof(line),
+                  "frame %llu at %.2f s: %.2f ms work, %.2f ms since last frame, %d steps, %llu heap allocs |"
+                  " input %.2f enemies %.2f combat %.2f physics %.2f explore %.2f actions %.2f hash %.2f"
+                  " autosave %.2f hud %.2f render %.2f\n",
+                  static_cast<unsigned long long>(frameIndex_),
+                  perfClockSeconds_,
+                  static_cast<double>(workMs),
+                  static_cast<double>(frameMs),
+                  t.steps,
+                  static_cast<unsigned long long>(frameHeapAllocations_),
+                  static_cast<double>(t.input),
+                  static_cast<double>(t.enemies),
+                  static_cast<double>(t.combat),
+                  static_cast<double>(t.physics),
+                  static_cast<double>(t.explore),
+                  static_cast<double>(t.actions),
+                  static_cast<double>(t.stateHash),
+                  static_cast<double>(t.autosave),
+                  static_cast<double>(t.hud),
+                  static_cast<double>(t.render));
+    hitchLog_ << line;
+    hitchLog_.flush();
 }
 
 void Game::shutdown() {
+    if (hitchCount_ > 0) {
+        std::fprintf(stderr, "%u hitches over %.1f ms logged to %s\n",
+                     hitchCount_,
+                     static_cast<double>(config_.hitchThresholdMs),
+                     config_.hitchLogPath.c_str());
+    }
+    if (config_.deterministic) {
+        std::fprintf(stderr,
+                     "final tick %llu state %016llx\n",
+                     static_cast<unsigned long long>(simulationTick_),
+                     static_cast<unsigned long long>(stateHash_));
+    }
     saveActiveSession();
+    autosave_.shutdown();
+    pollAutosave();
+    worldLog_.close();
+    playerLog_.close();
     inputSystem_->shutdown();
     renderer_->shutdown();
 }
 
-void Game::handleInput() {
+void Game::handleInput(float frameSeconds) {
+    TERRARIA_TRACE_ZONE("handleInput");
+    const core::ScopedTimer timer{systemTimes_.input};
     inputSystem_->poll();
     const auto& inputState = inputSystem_->state();
+    if (inputState.perfToggle) {
+        perfExpanded_ = !perfExpanded_;
+    }
     if (menuSystem_.isGameplay() && inputState.menuBack) {
         if (chatConsole_.isOpen()) {
             chatConsole_.close();
@@ -178,7 +369,7 @@ void Game::handleInput() {
         }
         if (action.type == MenuSystem::MenuAction::Type::Save) {
             saveActiveSession();
-            chatConsole_.addMessage("GAME SAVED", true);
+            saveNoticePending_ = true;
             menuSystem_.resumeGameplay();
             paused_ = false;
             return;
@@ -213,14 +404,14 @@ void Game::handleInput() {
         }
         if (action.type == MenuSystem::MenuAction::Type::CreateWorld) {
             const std::uint32_t seed = action.seed.empty()
-                ? generateSeed()
+                ? sessionSeed(config_)
                 : static_cast<std::uint32_t>(std::strtoul(action.seed.c_str(), nullptr, 10));
             world_ = world::World(config_.worldWidth, config_.worldHeight);
             generator_.generate(world_, seed, action.genConfig);
             const entities::Vec2 spawn = findSpawnPosition();
             const std::string worldId = saveManager_.createWorldId(worldList_);
             const float defaultTime = 0.0F;
-            saveManager_.saveWorld(worldId, action.name, world_, seed, spawn.x, spawn.y, defaultTime, false);
+            saveManager_.saveWorld(worldId, action.name, world_, seed, action.genConfig, spawn.x, spawn.y, defaultTime, false);
             worldList_ = saveManager_.listWorlds();
             for (std::size_t i = 0; i < worldList_.size(); ++i) {
                 if (worldList_[i].id == worldId) {
@@ -256,6 +447,7 @@ void Game::handleInput() {
         }
     }
     if (minimapFullscreen_) {
+        updateFullscreenMap(inputState, frameSeconds);
         return;
     }
     if (!chatConsole_.isOpen()) {
@@ -336,7 +528,7 @@ void Game::handleInput() {
     paused_ = inventoryOpen || cameraMode_ || chatConsole_.isOpen();
     if (cameraMode_) {
         const float moveSpeed = cameraSpeed_;
-        const float delta = moveSpeed / static_cast<float>(config_.targetFps);
+        const float delta = moveSpeed * std::min(frameSeconds, kMaxFrameSeconds);
         cameraPosition_.x += inputState.camMoveX * delta;
         cameraPosition_.y += inputState.camMoveY * delta;
         cameraPosition_ = clampCameraTarget(cameraPosition_);
@@ -374,21 +566,65 @@ void Game::handleInput() {
 }
 
 void Game::saveActiveSession() {
-    if (activeWorldId_.empty() || activeCharacterId_.empty()) {
+    if (!config_.persistSaves || activeWorldId_.empty() || activeCharacterId_.empty()) {
         return;
     }
-    saveManager_.saveWorld(activeWorldId_,
-                           activeWorldName_,
-                           world_,
-                           worldSeed_,
-                           worldSpawn_.x,
-                           worldSpawn_.y,
-                           timeOfDay_,
-                           isNight_);
-    saveManager_.saveCharacter(activeCharacterId_, activeCharacterName_, player_);
+    TERRARIA_TRACE_MARKER("checkpoint");
+    const std::uint64_t tag = ++checkpointTag_;
+    pendingCheckpoints_.push_back({tag, worldLog_.rotate(), playerLog_.rotate()});
+    autosave_.submit(SaveManager::snapshotWorld(activeWorldId_,
+                                                activeWorldName_,
+                                                world_,
+                                                worldSeed_,
+                                                worldGenConfig_,
+                                                worldSpawn_.x,
+                                                worldSpawn_.y,
+                                                timeOfDay_,
+                                                isNight_),
+                     CharacterSnapshot{activeCharacterId_, activeCharacterName_, player_},
+                     tag);
+}
+
+void Game::pollAutosave() {
+    TERRARIA_TRACE_ZONE("pollAutosave");
+    const core::ScopedTimer timer{systemTimes_.autosave};
+    bool ok = true;
+    std::uint64_t savedTag = 0;
+    if (!autosave_.pollCompleted(ok, savedTag)) {
+        return;
+    }
+    // Segments closed at or before the newest written checkpoint are covered by it.
+    std::uint64_t worldThrough = 0;
+    std::uint64_t playerThrough = 0;
+    for (const auto& checkpoint : pendingCheckpoints_) {
+        if (checkpoint.tag <= savedTag) {
+            worldThrough = std::max(worldThrough, checkpoint.worldGeneration);
+            playerThrough = std::max(playerThrough, checkpoint.playerGeneration);
+        }
+    }
+    worldLog_.discardThrough(worldThrough);
+    playerLog_.discardThrough(playerThrough);
+    pendingCheckpoints_.erase(std::remove_if(pendingCheckpoints_.begin(),
+                                             pendingCheckpoints_.end(),
+                                             [savedTag](const PendingCheckpoint& checkpoint) {
+                                                 return checkpoint.tag <= savedTag;
+                                             }),
+                              pendingCheckpoints_.end());
+    if (!ok) {
+        chatConsole_.addMessage("SAVE FAILED", true);
+    } else if (saveNoticePending_) {
+        chatConsole_.addMessage("GAME SAVED", true);
+    }
+    saveNoticePending_ = false;
+    if (!menuSystem_.isGameplay() && activeWorldId_.empty()) {
+        characterList_ = saveManager_.listCharacters();
+        worldList_ = saveManager_.listWorlds();
+    }
 }
 
 void Game::clearActiveSession() {
+    worldLog_.close();
+    playerLog_.close();
     world_ = world::World(config_.worldWidth, config_.worldHeight);
     player_ = entities::Player{};
     enemyManager_.reset();
@@ -413,8 +649,10 @@ void Game::clearActiveSession() {
     timeOfDay_ = 0.0F;
     isNight_ = false;
     worldSeed_ = 0;
+    worldGenConfig_ = {};
     worldSpawn_ = {};
     activeWorldId_.clear();
+    mapKey_.clear();
     activeWorldName_.clear();
     activeCharacterId_.clear();
     activeCharacterName_.clear();
@@ -422,44 +660,47 @@ void Game::clearActiveSession() {
     chatConsole_.close();
 }
 
+void Game::updateFullscreenMap(const input::InputState& inputState, float frameSeconds) {
+    if (inputState.minimapZoomIn) {
+        fullscreenMapZoom_ = std::min(16.0F, fullscreenMapZoom_ + 0.5F);
+    }
+    if (inputState.minimapZoomOut) {
+        fullscreenMapZoom_ = std::max(1.0F, fullscreenMapZoom_ - 0.5F);
+    }
+    const float panSpeed = 220.0F;
+    minimapCenterX_ += inputState.camMoveX * panSpeed * frameSeconds;
+    minimapCenterY_ += inputState.camMoveY * panSpeed * frameSeconds;
+    if (inputState.minimapDrag) {
+        const float dragScale = 1.0F;
+        minimapCenterX_ -= static_cast<float>(inputState.mouseDeltaX) * dragScale;
+        minimapCenterY_ -= static_cast<float>(inputState.mouseDeltaY) * dragScale;
+    }
+    const float worldW = static_cast<float>(world_.width());
+    const float worldH = static_cast<float>(world_.height());
+    const float zoom = fullscreenMapZoom_;
+    const float mapW = static_cast<float>(config_.windowWidth);
+    const float mapH = static_cast<float>(config_.windowHeight);
+    const float basePerPixelX = worldW / std::max(1.0F, mapW);
+    const float basePerPixelY = worldH / std::max(1.0F, mapH);
+    const float worldPerPixel = std::max(basePerPixelX, basePerPixelY) / zoom;
+    const float spanX = worldPerPixel * mapW;
+    const float spanY = worldPerPixel * mapH;
+    const float minX = spanX * 0.5F;
+    const float maxX = worldW - spanX * 0.5F;
+    const float minY = spanY * 0.5F;
+    const float maxY = worldH - spanY * 0.5F;
+    minimapCenterX_ = (minX <= maxX)
+        ? std::clamp(minimapCenterX_, minX, maxX)
+        : worldW * 0.5F;
+    minimapCenterY_ = (minY <= maxY)
+        ? std::clamp(minimapCenterY_, minY, maxY)
+        : worldH * 0.5F;
+}
+
 void Game::update(float dt) {
+    TERRARIA_TRACE_ZONE("update");
     chatConsole_.update(dt);
     if (minimapFullscreen_) {
-        const auto& inputState = inputSystem_->state();
-        if (inputState.minimapZoomIn) {
-            fullscreenMapZoom_ = std::min(16.0F, fullscreenMapZoom_ + 0.5F);
-        }
-        if (inputState.minimapZoomOut) {
-            fullscreenMapZoom_ = std::max(1.0F, fullscreenMapZoom_ - 0.5F);
-        }
-        const float panSpeed = 220.0F;
-        minimapCenterX_ += inputState.camMoveX * panSpeed * dt;
-        minimapCenterY_ += inputState.camMoveY * panSpeed * dt;
-        if (inputState.minimapDrag) {
-            const float dragScale = 1.0F;
-            minimapCenterX_ -= static_cast<float>(inputState.mouseDeltaX) * dragScale;
-            minimapCenterY_ -= static_cast<float>(inputState.mouseDeltaY) * dragScale;
-        }
-        const float worldW = static_cast<float>(world_.width());
-        const float worldH = static_cast<float>(world_.height());
-        const float zoom = fullscreenMapZoom_;
-        const float mapW = static_cast<float>(config_.windowWidth);
-        const float mapH = static_cast<float>(config_.windowHeight);
-        const float basePerPixelX = worldW / std::max(1.0F, mapW);
-        const float basePerPixelY = worldH / std::max(1.0F, mapH);
-        const float worldPerPixel = std::max(basePerPixelX, basePerPixelY) / zoom;
-        const float spanX = worldPerPixel * mapW;
-        const float spanY = worldPerPixel * mapH;
-        const float minX = spanX * 0.5F;
-        const float maxX = worldW - spanX * 0.5F;
-        const float minY = spanY * 0.5F;
-        const float maxY = worldH - spanY * 0.5F;
-        minimapCenterX_ = (minX <= maxX)
-            ? std::clamp(minimapCenterX_, minX, maxX)
-            : worldW * 0.5F;
-        minimapCenterY_ = (minY <= maxY)
-            ? std::clamp(minimapCenterY_, minY, maxY)
-            : worldH * 0.5F;
         return;
     }
     if (!menuSystem_.isGameplay()) {
@@ -468,6 +709,11 @@ void Game::update(float dt) {
     if (paused_) {
         return;
     }
+    if (autosave_.tick(dt)) {
+        saveActiveSession();
+    }
+    bodies_.clear();
+    playerBody_ = kNoBody;
     if (!cameraMode_) {
         jumpBufferTimer_ = std::max(0.0F, jumpBufferTimer_ - dt);
         if (player_.onGround()) {
@@ -507,28 +753,49 @@ void Game::update(float dt) {
             velocity.y += kJumpReleaseGravityBoost * jumpModifier * dt;
         }
 
-        entities::Vec2 position = player_.position();
-        position.x += velocity.x * dt;
-        physics_.resolveHorizontalAabb(position, velocity, entities::kPlayerHalfWidth, entities::kPlayerHeight);
-
-        position.y += velocity.y * dt;
-        bool grounded = player_.onGround();
-        physics_.resolveVerticalAabb(position, velocity, entities::kPlayerHalfWidth, entities::kPlayerHeight, grounded);
-        player_.setOnGround(grounded);
-
-        const float maxX = static_cast<float>(world_.width() - 1);
-        const float maxY = static_cast<float>(world_.height() - 1);
-        position.x = std::clamp(position.x, 0.0F, maxX);
-        position.y = std::clamp(position.y, 0.0F, maxY);
-
-        player_.setPosition(position);
-        player_.setVelocity(velocity);
-        cameraPosition_ = clampCameraTarget(position);
+        // Gravity stays above so the jump and release boost see it in the same order as before.
+        const BodyBounds worldBounds{0.0F, 0.0F, static_cast<float>(world_.width() - 1), static_cast<float>(world_.height() - 1)};
+        playerBody_ = bodies_.add(player_.position(),
+                                  velocity,
+                                  entities::kPlayerHalfWidth,
+                                  entities::kPlayerHeight,
+                                  0.0F,
+                                  player_.onGround() ? static_cast<std::uint8_t>(kBodyCollides | kBodyOnGround) : kBodyCollides,
+                                  worldBounds);
     }
 
     updateDayNight(dt);
-    enemyManager_.update(dt, isNight_, cameraFocus());
-    combatSystem_.update(dt);
+    {
+        TERRARIA_TRACE_ZONE("enemies.update");
+        const core::ScopedTimer timer{systemTimes_.enemies};
+        enemyManager_.update(dt, isNight_, cameraFocus(), bodies_);
+    }
+    {
+        TERRARIA_TRACE_ZONE("combat.update");
+        const core::ScopedTimer timer{systemTimes_.combat};
+        combatSystem_.update(dt, bodies_);
+    }
+    {
+        TERRARIA_TRACE_ZONE("physics.step");
+        const core::ScopedTimer timer{systemTimes_.physics};
+        physics_.step(bodies_, dt);
+    }
+    if (playerBody_ != kNoBody) {
+        player_.setOnGround(bodies_.has(playerBody_, kBodyOnGround));
+        player_.setPosition(bodies_.position(playerBody_));
+        player_.setVelocity(bodies_.velocity(playerBody_));
+        cameraPosition_ = clampCameraTarget(player_.position());
+    }
+    {
+        TERRARIA_TRACE_ZONE("enemies.resolve");
+        const core::ScopedTimer timer{systemTimes_.enemies};
+        enemyManager_.resolve(isNight_, bodies_);
+    }
+    {
+        TERRARIA_TRACE_ZONE("combat.resolve");
+        const core::ScopedTimer timer{systemTimes_.combat};
+        combatSystem_.resolve(dt, bodies_);
+    }
     damageNumbers_.update(dt);
     if (player_.health() <= 0) {
         player_.resetHealth();
@@ -539,35 +806,87 @@ void Game::update(float dt) {
             dragon->health = dragon->maxHealth;
         }
     }
+    playerLog_.appendPlayer(player_);
     revealExploredTiles();
 }
 
 void Game::render() {
-    renderer_->render(world_, player_, enemyManager_.zombies(), hudState_);
+    TERRARIA_TRACE_ZONE("render");
+    const core::ScopedTimer timer{systemTimes_.render};
+    renderer_->render(world_, player_, hudState_, frameArena_);
+}
+
+void Game::processInterfaceInput() {
+    if (chatConsole_.isOpen() || !menuSystem_.isGameplay()) {
+        return;
+    }
+    const bool equipmentHandled = inventorySystem_.handleInput();
+    craftingSystem_.handlePointerInput(inventorySystem_.isOpen(), equipmentHandled);
 }
 
 void Game::processActions(float dt) {
+    TERRARIA_TRACE_ZONE("processActions");
+    const core::ScopedTimer timer{systemTimes_.actions};
     if (chatConsole_.isOpen()) {
         return;
     }
     if (!menuSystem_.isGameplay()) {
         return;
     }
-    const bool equipmentHandled = inventorySystem_.handleInput();
     if (!paused_ && !inventorySystem_.isOpen()) {
         handleBreaking(dt);
         handlePlacement(dt);
     } else {
         breakState_ = {};
     }
-    craftingSystem_.handlePointerInput(inventorySystem_.isOpen(), equipmentHandled);
     craftingSystem_.update(dt);
 }
 
+void Game::stepSimulation() {
+    TERRARIA_TRACE_ZONE("stepSimulation");
+    ++systemTimes_.steps;
+    storePreviousState();
+    update(simulationStep_);
+    processActions(simulationStep_);
+    recordStateHash();
+}
+
+void Game::recordStateHash() {
+    TERRARIA_TRACE_ZONE("recordStateHash");
+    const core::ScopedTimer timer{systemTimes_.stateHash};
+    StateHasher hasher;
+    hasher.add(stateHash_);
+    hasher.add(simulationTick_);
+    for (std::uint64_t chunkHash : world_.chunkHashes()) {
+        hasher.add(chunkHash);
+    }
+    hasher.add(player_.position());
+    hasher.add(player_.velocity());
+    hasher.add(player_.health());
+    hasher.add(player_.onGround());
+    hasher.add(timeOfDay_);
+    enemyManager_.hashState(hasher);
+    combatSystem_.hashState(hasher);
+    stateHash_ = hasher.value();
+    ++simulationTick_;
+}
+
+void Game::storePreviousState() {
+    player_.storePreviousPosition();
+    enemyManager_.storePreviousPositions();
+    combatSystem_.storePreviousPositions();
+}
+
 void Game::loadOrCreateSaves() {
-    saveManager_.ensureDirectories();
-    characterList_ = saveManager_.listCharacters();
-    worldList_ = saveManager_.listWorlds();
+    // Without persistence nothing may touch the save directory, not even to create it or refresh its index.
+    if (config_.persistSaves) {
+        saveManager_.ensureDirectories();
+        characterList_ = saveManager_.listCharacters();
+        worldList_ = saveManager_.listWorlds();
+    } else {
+        characterList_.clear();
+        worldList_.clear();
+    }
 
     if (worldList_.empty()) {
         world_ = world::World(config_.worldWidth, config_.worldHeight);
@@ -580,6 +899,7 @@ void Game::loadOrCreateSaves() {
     activeCharacterId_.clear();
     activeCharacterName_.clear();
     activeWorldId_.clear();
+    mapKey_.clear();
     activeWorldName_.clear();
     menuSystem_.setCharacterSelection(0);
     menuSystem_.setWorldSelection(0);
@@ -589,54 +909,92 @@ void Game::loadOrCreateSaves() {
 }
 
 void Game::startSession(const WorldInfo& worldInfo, const CharacterInfo& characterInfo) {
+    TERRARIA_TRACE_ZONE("startSession");
     activeWorldId_ = worldInfo.id;
     activeWorldName_ = worldInfo.name;
     activeCharacterId_ = characterInfo.id;
     activeCharacterName_ = characterInfo.name;
 
+    autosave_.waitIdle();
+    pollAutosave();
+    pendingCheckpoints_.clear();
+    autosave_.resetTimer();
     std::string loadedWorldName{};
     float loadedTime = 0.0F;
     bool loadedNight = false;
     std::uint32_t loadedSeed = 0;
     float loadedSpawnX = 0.0F;
     float loadedSpawnY = 0.0F;
-    if (!saveManager_.loadWorld(activeWorldId_, world_, loadedWorldName, loadedSeed, loadedSpawnX, loadedSpawnY, loadedTime, loadedNight)) {
+    world::WorldGenerator::WorldGenConfig loadedGenConfig{};
+    // An autostarted session is a throwaway: leftover saves under its id must not change the run.
+    const bool fromSaves = !config_.autoStartSession;
+    if (!fromSaves
+        || !saveManager_.loadWorld(activeWorldId_,
+                                   world_,
+                                   loadedWorldName,
+                                   loadedSeed,
+                                   loadedGenConfig,
+                                   loadedSpawnX,
+                                   loadedSpawnY,
+                                   loadedTime,
+                                   loadedNight)) {
         world_ = world::World(config_.worldWidth, config_.worldHeight);
-        loadedSeed = (worldInfo.seed != 0) ? worldInfo.seed : generateSeed();
-        generator_.generate(world_, loadedSeed);
+        loadedSeed = (worldInfo.seed != 0) ? worldInfo.seed : sessionSeed(config_);
+        loadedGenConfig = {};
+        generator_.generate(world_, loadedSeed, loadedGenConfig);
         loadedWorldName = activeWorldName_;
         const entities::Vec2 spawn = findSpawnPosition();
         loadedSpawnX = spawn.x;
         loadedSpawnY = spawn.y;
         loadedTime = 0.0F;
         loadedNight = false;
-        saveManager_.saveWorld(activeWorldId_,
-                               loadedWorldName,
-                               world_,
-                               loadedSeed,
-                               loadedSpawnX,
-                               loadedSpawnY,
-                               loadedTime,
-                               loadedNight);
+        if (config_.persistSaves) {
+            saveManager_.saveWorld(activeWorldId_,
+                                   loadedWorldName,
+                                   world_,
+                                   loadedSeed,
+                                   loadedGenConfig,
+                                   loadedSpawnX,
+                                   loadedSpawnY,
+                                   loadedTime,
+                                   loadedNight);
+        }
     }
     activeWorldName_ = loadedWorldName;
     timeOfDay_ = loadedTime;
     isNight_ = loadedNight;
     worldSeed_ = loadedSeed;
+    // Looked up every frame by fog and minimap; built once per session.
+    mapKey_ = activeWorldId_ + "#" + std::to_string(worldSeed_);
+    worldGenConfig_ = loadedGenConfig;
     worldSpawn_ = {loadedSpawnX, loadedSpawnY};
     if (worldSpawn_.y <= 0.5F) {
         worldSpawn_ = findSpawnPosition();
     }
 
     std::string loadedCharName{};
-    if (!saveManager_.loadCharacter(activeCharacterId_, player_, loadedCharName)) {
+    if (!fromSaves || !saveManager_.loadCharacter(activeCharacterId_, player_, loadedCharName)) {
         player_ = entities::Player{};
         applyDefaultLoadout(player_);
         loadedCharName = activeCharacterName_;
     }
     activeCharacterName_ = loadedCharName;
+    if (fromSaves) {
+        saveManager_.loadExploredMap(activeCharacterId_, currentMapKey(), player_);
+    }
     player_.ensureExploredSize(currentMapKey(), world_.width(), world_.height());
 
+    // Edits logged after the last checkpoint survive a crash; replay them, then keep logging.
+    if (fromSaves) {
+        EditLog::replay(saveManager_.editLogDir(), activeWorldId_, &world_, nullptr);
+        EditLog::replay(saveManager_.editLogDir(), activeCharacterId_, nullptr, &player_);
+    }
+    if (config_.persistSaves) {
+        worldLog_.open(saveManager_.editLogDir(), activeWorldId_);
+        playerLog_.open(saveManager_.editLogDir(), activeCharacterId_);
+    }
+    world_.setEditListener([this](int x, int y, std::uint8_t cell) { worldLog_.appendTile(x, y, cell); });
+
     entities::Vec2 desired = worldSpawn_;
     entities::Vec2 spawnSafe = worldSpawn_;
     if (!findNearestOpenSpot(worldSpawn_, spawnSafe)) {
@@ -655,6 +1013,10 @@ void Game::startSession(const WorldInfo& worldInfo, const CharacterInfo& charact
     cameraPosition_ = clampCameraTarget(safeSpot);
 
     enemyManager_.reset();
+    enemyManager_.seed(config_.deterministic ? config_.simulationSeed ^ worldSeed_ : generateSeed());
+    simulationTick_ = 0;
+    stateHash_ = 0;
+    accumulator_ = 0.0F;
     const auto denInfo = generator_.dragonDenInfo(world_, worldSeed_);
     const bool denOpen = denInfo.radiusX > 0 && denInfo.radiusY > 0
         && denInfo.centerX >= 0 && denInfo.centerX < world_.width()
@@ -769,21 +1131,16 @@ bool Game::cursorWorldTile(int& outX, int& outY) const {
         return true;
     }
 
-    const float dirX = dx / distance;
-    const float dirY = dy / distance;
-    const float maxDistance = kPlaceRange - 0.1F;
-    const float step = 0.25F;
-    float traveled = 0.0F;
-    while (traveled + step < maxDistance) {
-        traveled += step;
+    // Out of reach: pick the first tile between the player and the cursor, else the farthest reachable cell.
+    const entities::Vec2 eye{player_.position().x, player_.position().y - entities::kPlayerHeight * 0.5F};
+    const RayHit pick = physics_.raycast(eye, {worldX - eye.x, worldY - eye.y}, kPlaceRange - 0.1F, kAnyTileMask);
+    if (pick.hit && pick.tileX >= 0 && pick.tileX < world_.width() && pick.tileY >= 0 && pick.tileY < world_.height()) {
+        outX = pick.tileX;
+        outY = pick.tileY;
+        return true;
     }
-    traveled = std::min(traveled, maxDistance);
-
-    float posX = player_.position().x + dirX * traveled;
-    float posY = player_.position().y + dirY * traveled;
-    posX = std::clamp(posX, 0.0F, widthF - 0.0001F);
-    posY = std::clamp(posY, 0.0F, heightF - 0.0001F);
-
+    const float posX = std::clamp(pick.point.x, 0.0F, widthF - 0.0001F);
+    const float posY = std::clamp(pick.point.y, 0.0F, heightF - 0.0001F);
     outX = static_cast<int>(posX);
     outY = static_cast<int>(posY);
     return true;
@@ -1092,6 +1449,7 @@ float Game::breakSpeedMultiplier(world::TileType tileType) const {
 }
 
 void Game::updateDayNight(float dt) {
+    TERRARIA_TRACE_ZONE("updateDayNight");
     if (dayLength_ <= 0.001F) {
         isNight_ = false;
         return;
@@ -1123,9 +1481,15 @@ void Game::recordPerformanceMetrics(float frameMs, float updateMs, float renderM
     perfUpdateTimeMs_ = smooth(perfUpdateTimeMs_, updateMs);
     perfRenderTimeMs_ = smooth(perfRenderTimeMs_, renderMs);
     perfFps_ = (perfFrameTimeMs_ > 0.0001F) ? (1000.0F / perfFrameTimeMs_) : static_cast<float>(config_.targetFps);
+    perfClockSeconds_ += static_cast<double>(frameMs) / 1000.0;
+    frameTimes_.add(perfClockSeconds_, frameMs);
+    updateTimes_.add(perfClockSeconds_, updateMs);
+    renderTimes_.add(perfClockSeconds_, renderMs);
 }
 
 void Game::updateHudState() {
+    TERRARIA_TRACE_ZONE("updateHudState");
+    const core::ScopedTimer timer{systemTimes_.hud};
     const auto& inputState = inputSystem_->state();
     const auto fillSlot = [this](const entities::InventorySlot& src, rendering::HotbarSlotHud& dst) {
         dst = {};
@@ -1227,6 +1591,9 @@ void Game::updateHudState() {
     hudState_.useCamera = cameraMode_;
     hudState_.cameraX = cameraPosition_.x;
     hudState_.cameraY = cameraPosition_.y;
+    const entities::Vec2 renderPlayer = entities::Interpolate(player_.previousPosition(), playerPos, renderAlpha_);
+    hudState_.playerX = renderPlayer.x;
+    hudState_.playerY = renderPlayer.y;
     hudState_.playerHealth = player_.health();
     hudState_.playerMaxHealth = player_.maxHealth();
     hudState_.playerDefense = player_.defense();
@@ -1240,14 +1607,29 @@ void Game::updateHudState() {
     hudState_.isNight = isNight_;
     hudState_.bowDrawProgress = std::clamp(bowDrawTimer_ / kBowDrawTime, 0.0F, 1.0F);
     craftingSystem_.fillHud(hudState_);
-    combatSystem_.fillHud(hudState_);
-    enemyManager_.fillHud(hudState_);
+    combatSystem_.fillHud(hudState_, renderAlpha_);
+    enemyManager_.fillHud(hudState_, renderAlpha_);
     damageNumbers_.fillHud(hudState_);
 
     hudState_.perfFrameMs = perfFrameTimeMs_;
     hudState_.perfUpdateMs = perfUpdateTimeMs_;
     hudState_.perfRenderMs = perfRenderTimeMs_;
     hudState_.perfFps = perfFps_;
+    hudState_.perfHeapAllocations = frameHeapAllocations_;
+    hudState_.perfExpanded = perfExpanded_;
+    hudState_.perfHitches = hitchCount_;
+    if (perfExpanded_) {
+        hudState_.perfFrameTiming = frameTimes_.summary();
+        hudState_.perfUpdateTiming = updateTimes_.summary();
+        hudState_.perfRenderTiming = renderTimes_.summary();
+        hudState_.perfFrameHistogram = frameTimes_.buckets();
+        for (std::size_t tag = 0; tag < core::kMemoryTagCount; ++tag) {
+            hudState_.perfMemory[tag] = core::MemoryUsage(static_cast<core::MemoryTag>(tag));
+        }
+    }
+    hudState_.simulationTick = simulationTick_;
+    hudState_.stateHash = stateHash_;
+    hudState_.saving = autosave_.saving();
     hudState_.mouseX = std::clamp(inputState.mouseX, 0, config_.windowWidth);
     hudState_.mouseY = std::clamp(inputState.mouseY, 0, config_.windowHeight);
     hudState_.minimapZoom = minimapZoom_;
@@ -1268,10 +1650,12 @@ void Game::toggleCameraMode() {
 }
 
 void Game::revealExploredTiles() {
+    TERRARIA_TRACE_ZONE("revealExploredTiles");
+    const core::ScopedTimer timer{systemTimes_.explore};
     if (world_.width() <= 0 || world_.height() <= 0) {
         return;
     }
-    const std::string mapKey = currentMapKey();
+    const std::string& mapKey = currentMapKey();
     if (mapKey.empty()) {
         return;
     }
@@ -1295,50 +1679,61 @@ void Game::revealExploredTiles() {
         const auto& neighbor = world_.tile(x, y);
         return neighbor.active() && neighbor.isSolid();
     };
-    for (int y = minY; y <= maxY; ++y) {
-        for (int x = minX; x <= maxX; ++x) {
-            const auto& tile = world_.tile(x, y);
-            std::uint8_t value = 255;
-            if (tile.active() && tile.isSolid()) {
-                bool foundAir = false;
-                int distanceToAir = kFogRadius + 1;
-                for (int r = 1; r <= kFogRadius && !foundAir; ++r) {
-                    for (int dx = -r; dx <= r && !foundAir; ++dx) {
-                        const int dy = r - std::abs(dx);
-                        if (dy == 0) {
-                            if (!neighborIsSolid(x + dx, y)) {
-                                foundAir = true;
-                                distanceToAir = r;
-                            }
-                        } else {
-                            if (!neighborIsSolid(x + dx, y + dy) || !neighborIsSolid(x + dx, y - dy)) {
-                                foundAir = true;
-                                distanceToAir = r;
+    // The neighbourhood search is read-only, so rows are scored in parallel; 0 marks cells left as they are.
+    const int columns = maxX - minX + 1;
+    const int rows = maxY - minY + 1;
+    if (columns <= 0 || rows <= 0) {
+        return;
+    }
+    fogScratch_.assign(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows), 0);
+    core::JobSystem::Shared().parallelFor(static_cast<std::size_t>(rows), 8, [&](std::size_t begin, std::size_t end) {
+        for (int y = minY + static_cast<int>(begin); y < minY + static_cast<int>(end); ++y) {
+            std::uint8_t* out = fogScratch_.data() + static_cast<std::size_t>(y - minY) * static_cast<std::size_t>(columns);
+            for (int x = minX; x <= maxX; ++x) {
+                const auto& tile = world_.tile(x, y);
+                std::uint8_t value = 255;
+                if (tile.active() && tile.isSolid()) {
+                    bool foundAir = false;
+                    int distanceToAir = kFogRadius + 1;
+                    for (int r = 1; r <= kFogRadius && !foundAir; ++r) {
+                        for (int dx = -r; dx <= r && !foundAir; ++dx) {
+                            const int dy = r - std::abs(dx);
+                            if (dy == 0) {
+                                if (!neighborIsSolid(x + dx, y)) {
+                                    foundAir = true;
+                                    distanceToAir = r;
+                                }
+                            } else {
+                                if (!neighborIsSolid(x + dx, y + dy) || !neighborIsSolid(x + dx, y - dy)) {
+                                    foundAir = true;
+                                    distanceToAir = r;
+                                }
                             }
                         }
                     }
+                    if (!foundAir) {
+                        continue;
+                    }
+                    const int spread = std::max(1, kFogRadius - 1);
+                    const int fogAlpha = kFogMinAlpha
+                        + (distanceToAir - 1) * (kFogMaxAlpha - kFogMinAlpha) / spread;
+                    const int visibleAlpha = 255 - fogAlpha;
+                    value = static_cast<std::uint8_t>(std::clamp(visibleAlpha, 0, 255));
                 }
-                if (!foundAir) {
-                    continue;
-                }
-                const int spread = std::max(1, kFogRadius - 1);
-                const int fogAlpha = kFogMinAlpha
-                    + (distanceToAir - 1) * (kFogMaxAlpha - kFogMinAlpha) / spread;
-                const int visibleAlpha = 255 - fogAlpha;
-                value = static_cast<std::uint8_t>(std::clamp(visibleAlpha, 0, 255));
+                out[x - minX] = value;
+            }
+        }
+    }, "fog");
+    for (int y = minY; y <= maxY; ++y) {
+        const std::uint8_t* row = fogScratch_.data() + static_cast<std::size_t>(y - minY) * static_cast<std::size_t>(columns);
+        for (int x = minX; x <= maxX; ++x) {
+            if (row[x - minX] != 0) {
+                player_.setExploredValue(mapKey, x, y, row[x - minX]);
             }
-            player_.setExploredValue(mapKey, x, y, value);
         }
     }
 }
 
-std::string Game::currentMapKey() const {
-    if (activeWorldId_.empty()) {
-        return {};
-    }
-    return activeWorldId_ + "#" + std::to_string(worldSeed_);
-}
-
 void Game::executeConsoleCommand(const std::string& text) {
     std::string command = text;
     command.erase(command.begin(), std::find_if(command.begin(), command.end(), [](unsigned char c) { return !std::isspace(c); }));
@@ -1465,7 +1860,7 @@ void Game::executeConsoleCommand(const std::string& text) {
         return;
     }
     if (verb == "reveal_map") {
-        const std::string mapKey = currentMapKey();
+        const std::string& mapKey = currentMapKey();
         if (mapKey.empty()) {
             chatConsole_.addMessage("NO WORLD", true);
             return;
@@ -1492,6 +1887,39 @@ void Game::executeConsoleCommand(const std::string& text) {
         chatConsole_.addMessage("USAGE: /locate dragon_den", true);
         return;
     }
+    if (verb == "trace") {
+        int frames = 0;
+        stream >> frames;
+        std::string path;
+        stream >> path;
+        if (frames <= 0) {
+            chatConsole_.addMessage("USAGE: /trace FRAMES [FILE]", true);
+        } else if (!core::kTracingCompiledIn) {
+            chatConsole_.addMessage("TRACING NOT BUILT IN", true);
+        } else if (!core::StartTraceCapture(frames, path.empty() ? config_.tracePath : path)) {
+            chatConsole_.addMessage("TRACE ALREADY RUNNING", true);
+        } else {
+            chatConsole_.addMessage("TRACING " + std::to_string(frames) + " FRAMES", true);
+        }
+        return;
+    }
+    if (verb == "mem") {
+        const auto megabytes = [](std::size_t bytes) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.2f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+            return std::string{buffer};
+        };
+        for (std::size_t tag = 0; tag < core::kMemoryTagCount; ++tag) {
+            const core::MemoryTagUsage usage = core::MemoryUsage(static_cast<core::MemoryTag>(tag));
+            chatConsole_.addMessage(std::string{core::MemoryTagName(static_cast<core::MemoryTag>(tag))} + " "
+                                        + megabytes(usage.live) + " PEAK " + megabytes(usage.peak),
+                                    true);
+        }
+        if (world_.mapped()) {
+            chatConsole_.addMessage("WORLD FILE MAPPED " + megabytes(world_.cellCount()), true);
+        }
+        return;
+    }
     if (verb == "tp") {
         float x = 0.0F;
         float y = 0.0F;
@@ -1,12 +1,40 @@
 #include "terraria/game/PhysicsSystem.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace terraria::game {
 
 namespace {
 constexpr float kCollisionEpsilon = 0.001F;
+constexpr int kMaxSubsteps = 64;
+constexpr unsigned kTileTypeCount = static_cast<unsigned>(world::TileType::TreeLeaves) + 1;
+
+bool stopsRay(std::uint8_t cell, TileMask mask) {
+    const unsigned type = cell & world::kTileTypeMask;
+    return (cell & world::kTileActiveBit) != 0 && type < 32 && ((mask >> type) & 1U) != 0;
+}
+
+// Entry and exit times of a moving [lo, hi] interval against the fixed [tileLo, tileLo + 1].
+bool axisInterval(float lo, float hi, float delta, float tileLo, float& entry, float& exit) {
+    const float tileHi = tileLo + 1.0F;
+    if (delta > 0.0F) {
+        entry = (tileLo - hi) / delta;
+        exit = (tileHi - lo) / delta;
+    } else if (delta < 0.0F) {
+        entry = (tileHi - lo) / delta;
+        exit = (tileLo - hi) / delta;
+    } else {
+        if (hi < tileLo || lo >= tileHi) {
+            return false;
+        }
+        entry = -std::numeric_limits<float>::infinity();
+        exit = std::numeric_limits<float>::infinity();
+    }
+    return true;
 }
+} // namespace
 
 PhysicsSystem::PhysicsSystem(const world::World& world)
     : world_{world} {}
@@ -113,4 +141,236 @@ bool PhysicsSystem::solidAtPosition(const entities::Vec2& pos) const {
     return isSolidTile(tileX, tileY);
 }
 
+SweepHit PhysicsSystem::sweepAabb(const entities::Vec2& position,
+                                  float halfWidth,
+                                  float height,
+                                  const entities::Vec2& displacement) const {
+    const float left = position.x - halfWidth;
+    const float right = position.x + halfWidth;
+    const float top = position.y - height;
+    const float bottom = position.y;
+
+    const int startX = static_cast<int>(std::floor(std::min(left, left + displacement.x)));
+    const int endX = static_cast<int>(std::floor(std::max(right, right + displacement.x)));
+    const int startY = static_cast<int>(std::floor(std::min(top, top + displacement.y)));
+    const int endY = static_cast<int>(std::floor(std::max(bottom, bottom + displacement.y)));
+
+    SweepHit best{};
+    for (int y = startY; y <= endY; ++y) {
+        for (int x = startX; x <= endX; ++x) {
+            if (!isSolidTile(x, y)) {
+                continue;
+            }
+            const auto tileX = static_cast<float>(x);
+            const auto tileY = static_cast<float>(y);
+            if (right > tileX && left < tileX + 1.0F && bottom > tileY && top < tileY + 1.0F) {
+                continue;
+            }
+            float entryX = 0.0F;
+            float exitX = 0.0F;
+            float entryY = 0.0F;
+            float exitY = 0.0F;
+            if (!axisInterval(left, right, displacement.x, tileX, entryX, exitX)
+                || !axisInterval(top, bottom, displacement.y, tileY, entryY, exitY)) {
+                continue;
+            }
+            const float entry = std::max(entryX, entryY);
+            const float exit = std::min(exitX, exitY);
+            if (entry > exit || entry < 0.0F || entry > 1.0F || (best.hit && entry >= best.time)) {
+                continue;
+            }
+            best.hit = true;
+            best.time = entry;
+            if (entryX > entryY) {
+                best.normal = {displacement.x > 0.0F ? -1.0F : 1.0F, 0.0F};
+            } else {
+                best.normal = {0.0F, displacement.y > 0.0F ? -1.0F : 1.0F};
+            }
+        }
+    }
+    return best;
+}
+
+void PhysicsSystem::moveAabb(entities::Vec2& position,
+                             entities::Vec2& velocity,
+                             float halfWidth,
+                             float height,
+                             float dt,
+                             bool& onGround) const {
+    const int steps = SubstepsFor({velocity.x * dt, velocity.y * dt});
+    const float stepDt = dt / static_cast<float>(steps);
+    for (int step = 0; step < steps; ++step) {
+        const float dx = velocity.x * stepDt;
+        const SweepHit hitX = sweepAabb(position, halfWidth, height, {dx, 0.0F});
+        if (hitX.hit) {
+            position.x += dx * hitX.time + hitX.normal.x * kCollisionEpsilon;
+            velocity.x = 0.0F;
+        } else {
+            position.x += dx;
+            resolveHorizontalAabb(position, velocity, halfWidth, height);
+        }
+
+        const float dy = velocity.y * stepDt;
+        if (step > 0 && dy == 0.0F) {
+            continue; // stopped vertically in an earlier substep; keep its ground contact
+        }
+        const SweepHit hitY = sweepAabb(position, halfWidth, height, {0.0F, dy});
+        if (hitY.hit) {
+            position.y += dy * hitY.time + hitY.normal.y * kCollisionEpsilon;
+            velocity.y = 0.0F;
+            onGround = hitY.normal.y < 0.0F;
+        } else {
+            position.y += dy;
+            resolveVerticalAabb(position, velocity, halfWidth, height, onGround);
+        }
+    }
+}
+
+int PhysicsSystem::SubstepsFor(const entities::Vec2& displacement) {
+    const float distance = std::max(std::fabs(displacement.x), std::fabs(displacement.y));
+    if (!(distance > 1.0F)) {
+        return 1;
+    }
+    return std::min(kMaxSubsteps, static_cast<int>(std::ceil(distance)));
+}
+
+void PhysicsSystem::step(BodyStore& bodies, float dt) const {
+    const std::size_t count = bodies.size();
+    float* posX = bodies.posX.data();
+    float* posY = bodies.posY.data();
+    float* velX = bodies.velX.data();
+    float* velY = bodies.velY.data();
+    const float* gravity = bodies.gravity.data();
+    const std::uint8_t* flags = bodies.flags.data();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        velY[i] += gravity[i] * dt;
+    }
+    // Free bodies integrate branch-free; tile-bound ones are moved below.
+    for (std::size_t i = 0; i < count; ++i) {
+        const float free = (flags[i] & (kBodyCollides | kBodyPoint)) == 0 ? dt : 0.0F;
+        posX[i] += velX[i] * free;
+        posY[i] += velY[i] * free;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint8_t& bodyFlags = bodies.flags[i];
+        if ((bodyFlags & kBodyCollides) != 0) {
+            entities::Vec2 position{posX[i], posY[i]};
+            entities::Vec2 velocity{velX[i], velY[i]};
+            bool onGround = (bodyFlags & kBodyOnGround) != 0;
+            moveAabb(position, velocity, bodies.halfWidth[i], bodies.height[i], dt, onGround);
+            posX[i] = position.x;
+            posY[i] = position.y;
+            velX[i] = velocity.x;
+            velY[i] = velocity.y;
+            bodyFlags = static_cast<std::uint8_t>(onGround ? (bodyFlags | kBodyOnGround) : (bodyFlags & ~kBodyOnGround));
+        } else if ((bodyFlags & kBodyPoint) != 0) {
+            const entities::Vec2 displacement{velX[i] * dt, velY[i] * dt};
+            const float travel = std::sqrt(displacement.x * displacement.x + displacement.y * displacement.y);
+            const RayHit hit = raycast({posX[i], posY[i]}, displacement, travel);
+            posX[i] = hit.point.x;
+            posY[i] = hit.point.y;
+            if (hit.hit) {
+                bodyFlags = static_cast<std::uint8_t>(bodyFlags | kBodyHitWall);
+            }
+        }
+    }
+
+    const float* minX = bodies.minX.data();
+    const float* minY = bodies.minY.data();
+    const float* maxX = bodies.maxX.data();
+    const float* maxY = bodies.maxY.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        posX[i] = std::min(std::max(posX[i], minX[i]), maxX[i]);
+        posY[i] = std::min(std::max(posY[i], minY[i]), maxY[i]);
+    }
+}
+
+TileMask PhysicsSystem::SolidTileMask() {
+    static const TileMask kMask = []() {
+        TileMask mask = 0;
+        for (unsigned type = 0; type < kTileTypeCount; ++type) {
+            const auto tileType = static_cast<world::TileType>(type);
+            if (world::SharedTile(world::PackTile(tileType, true)).isSolid()) {
+                mask |= TileBit(tileType);
+            }
+        }
+        return mask & kAnyTileMask;
+    }();
+    return kMask;
+}
+
+RayHit PhysicsSystem::raycast(const entities::Vec2& origin,
+                              const entities::Vec2& direction,
+                              float maxDistance,
+                              TileMask stopMask) const {
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    const float dirX = length > 0.0F ? direction.x / length : 0.0F;
+    const float dirY = length > 0.0F ? direction.y / length : 0.0F;
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+    int x = static_cast<int>(std::floor(origin.x));
+    int y = static_cast<int>(std::floor(origin.y));
+    const int stepX = dirX > 0.0F ? 1 : (dirX < 0.0F ? -1 : 0);
+    const int stepY = dirY > 0.0F ? 1 : (dirY < 0.0F ? -1 : 0);
+    const float deltaX = stepX != 0 ? 1.0F / std::fabs(dirX) : kInfinity;
+    const float deltaY = stepY != 0 ? 1.0F / std::fabs(dirY) : kInfinity;
+    float nextX = stepX > 0 ? (static_cast<float>(x + 1) - origin.x) * deltaX
+        : (stepX < 0 ? (origin.x - static_cast<float>(x)) * deltaX : kInfinity);
+    float nextY = stepY > 0 ? (static_cast<float>(y + 1) - origin.y) * deltaY
+        : (stepY < 0 ? (origin.y - static_cast<float>(y)) * deltaY : kInfinity);
+
+    RayHit result{};
+    entities::Vec2 normal{};
+    float distance = 0.0F;
+    while (true) {
+        // Like isSolidTile, the sides and bottom of the world are a wall that every ray stops at.
+        const bool border = x < 0 || x >= world_.width() || y >= world_.height();
+        if (y < 0 && !border) {
+            if (stepY <= 0 && stepX == 0) {
+                break; // straight up into open sky
+            }
+        } else if (border || stopsRay(world_.cell(x, y), stopMask)) {
+            result.hit = true;
+            result.tileX = x;
+            result.tileY = y;
+            result.distance = distance;
+            result.point = {origin.x + dirX * distance, origin.y + dirY * distance};
+            result.normal = normal;
+            return result;
+        }
+        if (nextX < nextY) {
+            distance = nextX;
+            x += stepX;
+            nextX += deltaX;
+            normal = {static_cast<float>(-stepX), 0.0F};
+        } else {
+            distance = nextY;
+            y += stepY;
+            nextY += deltaY;
+            normal = {0.0F, static_cast<float>(-stepY)};
+        }
+        if (!(distance <= maxDistance)) {
+            break;
+        }
+    }
+    result.distance = maxDistance;
+    result.point = {origin.x + dirX * maxDistance, origin.y + dirY * maxDistance};
+    return result;
+}
+
+bool PhysicsSystem::lineOfSight(const entities::Vec2& from, const entities::Vec2& to) const {
+    const entities::Vec2 delta{to.x - from.x, to.y - from.y};
+    const float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    return !raycast(from, delta, distance).hit;
+}
+
+void PhysicsSystem::raycastBatch(std::span<const Ray> rays, std::span<RayHit> hits, TileMask stopMask) const {
+    const std::size_t count = std::min(rays.size(), hits.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        hits[i] = raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance, stopMask);
+    }
+}
+
 } // namespace terraria::game
@@ -1,15 +1,43 @@
 #include "terraria/game/SaveManager.h"
 
+#include "terraria/core/Parallel.h"
+#include "terraria/core/Trace.h"
+
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <fstream>
+#include <span>
+#include <system_error>
 #include <unordered_set>
+#include <utility>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace terraria::game {
 
 namespace {
 
-constexpr std::uint16_t kSaveVersion = 6;
+constexpr std::uint16_t kCharacterVersion = 7;
+constexpr std::uint16_t kEmbeddedMapsCharacterVersion = 6;
+constexpr std::uint16_t kExploredMapVersion = 2;
+constexpr std::uint16_t kDenseExploredMapVersion = 1;
+constexpr std::uint8_t kMapTileUniform = 0;
+constexpr std::uint8_t kMapTileDetail = 1;
+constexpr std::size_t kMaxRunLength = 0xFFFF;
+constexpr std::uint16_t kWorldVersion = 10;
+constexpr std::uint16_t kUnhashedWorldVersion = 9;
+constexpr std::uint16_t kRawOnlyWorldVersion = 8;
+constexpr std::uint16_t kTilePairsWorldVersion = 6; // row-major (type, active) byte pairs, no generator config
+constexpr std::uint32_t kBlockChunks = 16;
+constexpr std::uint64_t kWorldDataAlignment = 4096;
+constexpr std::uint16_t kIndexVersion = 1;
 
 template <typename T>
 void writeValue(std::ostream& out, const T& value) {
@@ -91,10 +119,410 @@ void writeMagic(std::ostream& out, const char* magic) {
     out.write(magic, 4);
 }
 
+std::filesystem::path tempPathFor(const std::filesystem::path& path) {
+    auto temp = path;
+    temp += ".tmp";
+    return temp;
+}
+
+bool supportedWorldVersion(std::uint16_t version) {
+    return version == kWorldVersion || version == kUnhashedWorldVersion || version == kRawOnlyWorldVersion
+        || version == kTilePairsWorldVersion;
+}
+
+// Flushes a closed file, or a directory's entries, to disk so a rename cannot outlive the data it points at.
+bool syncPath(const std::filesystem::path& path, bool directory) {
+#if defined(_WIN32)
+    if (directory) {
+        return true; // directory handles cannot be flushed here; NTFS journals the rename itself
+    }
+    const int fd = _wopen(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = _commit(fd) == 0;
+    _close(fd);
+    return ok;
+#else
+    const int fd = ::open(path.c_str(), directory ? O_RDONLY | O_DIRECTORY : O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+void writeGenConfig(std::ostream& out, const world::WorldGenerator::WorldGenConfig& config) {
+    writeValue(out, config.terrainAmplitude);
+    writeValue(out, config.soilDepthScale);
+    writeValue(out, config.caveDensity);
+    writeValue(out, config.oreDensity);
+    writeValue(out, config.treeDensity);
+}
+
+bool readGenConfig(std::istream& in, world::WorldGenerator::WorldGenConfig& config) {
+    return readValue(in, config.terrainAmplitude) && readValue(in, config.soilDepthScale)
+        && readValue(in, config.caveDensity) && readValue(in, config.oreDensity) && readValue(in, config.treeDensity);
+}
+
+bool sameGenConfig(const world::WorldGenerator::WorldGenConfig& a, const world::WorldGenerator::WorldGenConfig& b) {
+    return a.terrainAmplitude == b.terrainAmplitude && a.soilDepthScale == b.soilDepthScale
+        && a.caveDensity == b.caveDensity && a.oreDensity == b.oreDensity && a.treeDensity == b.treeDensity;
+}
+
+bool supportedCharacterVersion(std::uint16_t version) {
+    return version == kCharacterVersion || version == kEmbeddedMapsCharacterVersion;
+}
+
+std::string mapRevisionKey(const std::string& characterId, const std::string& mapKey) {
+    return characterId + "/" + mapKey;
+}
+
+void writeRuns(std::ostream& out, std::span<const std::uint8_t> data) {
+    std::uint32_t runCount = 0;
+    const auto countPos = out.tellp();
+    writeValue(out, runCount);
+    std::size_t i = 0;
+    while (i < data.size()) {
+        const std::uint8_t value = data[i];
+        std::size_t length = 1;
+        while (i + length < data.size() && data[i + length] == value && length < kMaxRunLength) {
+            ++length;
+        }
+        writeValue(out, value);
+        writeValue(out, static_cast<std::uint16_t>(length));
+        ++runCount;
+        i += length;
+    }
+    const auto endPos = out.tellp();
+    out.seekp(countPos);
+    writeValue(out, runCount);
+    out.seekp(endPos);
+}
+
+bool readRuns(std::istream& in, std::span<std::uint8_t> data) {
+    std::uint32_t runCount = 0;
+    if (!readValue(in, runCount)) {
+        return false;
+    }
+    std::size_t filled = 0;
+    for (std::uint32_t i = 0; i < runCount; ++i) {
+        std::uint8_t value = 0;
+        std::uint16_t length = 0;
+        if (!readValue(in, value) || !readValue(in, length) || filled + length > data.size()) {
+            return false;
+        }
+        std::fill_n(data.begin() + static_cast<std::ptrdiff_t>(filled), length, value);
+        filled += length;
+    }
+    return filled == data.size();
+}
+
+using MapExploration = entities::Player::MapExploration;
+
+MapExploration tiledFromDense(int width, int height, const std::vector<std::uint8_t>& dense) {
+    MapExploration map{};
+    map.reset(width, height);
+    for (int ty = 0; ty < map.tilesY; ++ty) {
+        for (int tx = 0; tx < map.tilesX; ++tx) {
+            const auto tile = static_cast<std::size_t>(ty * map.tilesX + tx);
+            const int maxX = std::min((tx + 1) * MapExploration::kTileSize, width);
+            const int maxY = std::min((ty + 1) * MapExploration::kTileSize, height);
+            const std::uint8_t first = dense[static_cast<std::size_t>(ty * MapExploration::kTileSize * width + tx * MapExploration::kTileSize)];
+            bool same = true;
+            for (int y = ty * MapExploration::kTileSize; y < maxY && same; ++y) {
+                for (int x = tx * MapExploration::kTileSize; x < maxX && same; ++x) {
+                    same = dense[static_cast<std::size_t>(y * width + x)] == first;
+                }
+            }
+            if (same) {
+                map.uniform[tile] = first;
+                continue;
+            }
+            for (int y = ty * MapExploration::kTileSize; y < maxY; ++y) {
+                for (int x = tx * MapExploration::kTileSize; x < maxX; ++x) {
+                    map.raise(x, y, dense[static_cast<std::size_t>(y * width + x)]);
+                }
+            }
+        }
+    }
+    return map;
+}
+
+void encodeRunsInto(const std::uint8_t* data, std::size_t size, SaveBuffer& out) {
+    out.clear();
+    std::size_t i = 0;
+    while (i < size) {
+        const std::uint8_t value = data[i];
+        std::size_t length = 1;
+        while (i + length < size && data[i + length] == value && length < kMaxRunLength) {
+            ++length;
+        }
+        out.push_back(value);
+        out.push_back(static_cast<std::uint8_t>(length & 0xFF));
+        out.push_back(static_cast<std::uint8_t>(length >> 8));
+        i += length;
+    }
+}
+
+bool decodeRunsInto(const std::uint8_t* data, std::size_t size, std::uint8_t* dst, std::size_t dstSize) {
+    std::size_t filled = 0;
+    for (std::size_t i = 0; i + 2 < size; i += 3) {
+        const std::size_t length = static_cast<std::size_t>(data[i + 1]) | (static_cast<std::size_t>(data[i + 2]) << 8);
+        if (filled + length > dstSize) {
+            return false;
+        }
+        std::fill_n(dst + filled, length, data[i]);
+        filled += length;
+    }
+    return size % 3 == 0 && filled == dstSize;
+}
+
+std::int64_t modifiedTime(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return 0;
+    }
+    return static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+std::uint64_t fileSize(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : static_cast<std::uint64_t>(size);
+}
+
+template <typename Entry, typename ReadHeader>
+std::vector<Entry> rescanDirectory(const std::filesystem::path& dir,
+                                   const char* extension,
+                                   const std::vector<Entry>& cached,
+                                   ReadHeader readHeader) {
+    std::vector<Entry> result;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        const auto path = entry.path();
+        if (path.extension() != extension) {
+            continue;
+        }
+        const std::string id = path.stem().string();
+        const std::int64_t modified = modifiedTime(path);
+        const std::uint64_t size = fileSize(path);
+        const auto it = std::find_if(cached.begin(), cached.end(), [&](const Entry& e) { return e.info.id == id; });
+        if (it != cached.end() && it->modified == modified && it->size == size) {
+            result.push_back(*it);
+            continue;
+        }
+        Entry fresh{};
+        if (readHeader(path, fresh.info)) {
+            fresh.modified = modified;
+            fresh.size = size;
+            result.push_back(fresh);
+        }
+    }
+    return result;
+}
+
+template <typename Entry>
+void upsertEntry(std::vector<Entry>& entries, const Entry& entry) {
+    const auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& e) { return e.info.id == entry.info.id; });
+    if (it != entries.end()) {
+        *it = entry;
+    } else {
+        entries.push_back(entry);
+    }
+}
+
+void writeChunkHashes(std::ostream& out, const std::vector<std::uint64_t>& hashes) {
+    writeValue(out, static_cast<std::uint32_t>(hashes.size()));
+    out.write(reinterpret_cast<const char*>(hashes.data()),
+              static_cast<std::streamsize>(hashes.size() * sizeof(std::uint64_t)));
+}
+
+struct WorldFile {
+    std::uint16_t version{0};
+    std::string name{};
+    int width{0};
+    int height{0};
+    std::uint32_t seed{0};
+    float spawnX{0.0F};
+    float spawnY{0.0F};
+    float timeOfDay{0.0F};
+    bool isNight{false};
+    std::uint32_t generatorVersion{world::WorldGenerator::kVersion};
+    world::WorldGenerator::WorldGenConfig genConfig{};
+    std::uint8_t encoding{0};
+    std::vector<std::uint64_t> chunkHashes{}; // empty for saves older than kWorldVersion
+};
+
+// Reads everything up to the encoding-specific body, leaving the stream positioned at it.
+bool readWorldPrelude(std::istream& in, WorldFile& file) {
+    if (!readMagic(in, "WLD1") || !readValue(in, file.version) || !supportedWorldVersion(file.version)) {
+        return false;
+    }
+    if (!readString(in, file.name) || !readValue(in, file.width) || !readValue(in, file.height)) {
+        return false;
+    }
+    if (!readValue(in, file.seed) || !readValue(in, file.spawnX) || !readValue(in, file.spawnY)) {
+        return false;
+    }
+    std::uint8_t nightFlag = 0;
+    if (!readValue(in, file.timeOfDay) || !readValue(in, nightFlag)) {
+        return false;
+    }
+    file.isNight = nightFlag != 0;
+    if (file.version == kTilePairsWorldVersion) {
+        return file.width > 0 && file.height > 0;
+    }
+    if (file.version != kRawOnlyWorldVersion) {
+        if (!readValue(in, file.generatorVersion) || !readGenConfig(in, file.genConfig)) {
+            return false;
+        }
+    }
+    std::uint32_t chunkSize = 0;
+    if (!readValue(in, chunkSize)) {
+        return false;
+    }
+    if (chunkSize != static_cast<std::uint32_t>(world::World::kChunkSize) || file.width <= 0 || file.height <= 0) {
+        return false;
+    }
+    file.encoding = static_cast<std::uint8_t>(SaveManager::WorldEncoding::Raw);
+    if (file.version != kRawOnlyWorldVersion && !readValue(in, file.encoding)) {
+        return false;
+    }
+    if (file.version == kWorldVersion) {
+        std::uint32_t hashCount = 0;
+        if (!readValue(in, hashCount)
+            || hashCount != world::World::cellCountFor(file.width, file.height) / world::World::kChunkArea) {
+            return false;
+        }
+        file.chunkHashes.resize(hashCount);
+        in.read(reinterpret_cast<char*>(file.chunkHashes.data()),
+                static_cast<std::streamsize>(file.chunkHashes.size() * sizeof(std::uint64_t)));
+        if (!in) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readWorldFile(const std::filesystem::path& path, WorldFile& file, world::World& world, int threadCount) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in || !readWorldPrelude(in, file)) {
+        return false;
+    }
+    const int width = file.width;
+    const int height = file.height;
+    if (file.version == kTilePairsWorldVersion) {
+        world::World loaded(width, height);
+        std::vector<std::uint8_t> row(static_cast<std::size_t>(width) * 2);
+        for (int y = 0; y < height; ++y) {
+            in.read(reinterpret_cast<char*>(row.data()), static_cast<std::streamsize>(row.size()));
+            if (!in) {
+                return false;
+            }
+            for (int x = 0; x < width; ++x) {
+                const auto pair = static_cast<std::size_t>(x) * 2;
+                loaded.setTile(x, y, static_cast<world::TileType>(row[pair]), row[pair + 1] != 0);
+            }
+        }
+        world = std::move(loaded);
+    } else if (file.encoding == static_cast<std::uint8_t>(SaveManager::WorldEncoding::Delta)) {
+        if (file.generatorVersion != world::WorldGenerator::kVersion) {
+            return false;
+        }
+        std::uint32_t changedCount = 0;
+        if (!readValue(in, changedCount)) {
+            return false;
+        }
+        world::World loaded(width, height);
+        world::WorldGenerator generator;
+        generator.generate(loaded, file.seed, file.genConfig);
+        std::vector<std::uint8_t> cells(world::World::kChunkArea);
+        for (std::uint32_t i = 0; i < changedCount; ++i) {
+            std::uint32_t chunk = 0;
+            if (!readValue(in, chunk) || chunk >= loaded.chunkCount()) {
+                return false;
+            }
+            in.read(reinterpret_cast<char*>(cells.data()), static_cast<std::streamsize>(cells.size()));
+            if (!in) {
+                return false;
+            }
+            loaded.setChunk(chunk, cells.data());
+        }
+        loaded.setChunkHashes(file.chunkHashes);
+        world = std::move(loaded);
+    } else if (file.encoding == static_cast<std::uint8_t>(SaveManager::WorldEncoding::Blocks)) {
+        std::uint32_t blockChunks = 0;
+        std::uint32_t blockCount = 0;
+        if (!readValue(in, blockChunks) || !readValue(in, blockCount) || blockChunks == 0) {
+            return false;
+        }
+        world::World loaded(width, height);
+        if (static_cast<std::size_t>(blockCount) != (loaded.chunkCount() + blockChunks - 1) / blockChunks) {
+            return false;
+        }
+        std::vector<std::size_t> offsets(static_cast<std::size_t>(blockCount) + 1, 0);
+        for (std::uint32_t i = 0; i < blockCount; ++i) {
+            std::uint32_t size = 0;
+            if (!readValue(in, size)) {
+                return false;
+            }
+            offsets[i + 1] = offsets[i] + size;
+        }
+        SaveBuffer payload(offsets.back());
+        in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!in) {
+            return false;
+        }
+        std::atomic<bool> ok{true};
+        const bool rehash = file.chunkHashes.empty();
+        core::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+            const std::size_t firstChunk = block * blockChunks;
+            const std::size_t chunks = std::min<std::size_t>(blockChunks, loaded.chunkCount() - firstChunk);
+            if (!decodeRunsInto(payload.data() + offsets[block],
+                                offsets[block + 1] - offsets[block],
+                                loaded.chunkCells(firstChunk),
+                                chunks * world::World::kChunkArea)) {
+                ok.store(false, std::memory_order_relaxed);
+            } else if (rehash) {
+                for (std::size_t chunk = firstChunk; chunk < firstChunk + chunks; ++chunk) {
+                    loaded.rehashChunk(chunk);
+                }
+            }
+        });
+        if (!ok.load()) {
+            return false;
+        }
+        loaded.setChunkHashes(file.chunkHashes);
+        world = std::move(loaded);
+    } else if (file.encoding == static_cast<std::uint8_t>(SaveManager::WorldEncoding::Raw)) {
+        std::uint64_t dataOffset = 0;
+        if (!readValue(in, dataOffset)) {
+            return false;
+        }
+        in.close();
+        world::MappedRegion cells;
+        if (!cells.open(path, dataOffset, world::World::cellCountFor(width, height))) {
+            return false;
+        }
+        world = world::World(width, height, std::move(cells), file.chunkHashes);
+    } else {
+        return false;
+    }
+    return true;
+}
+
 } // namespace
 
 SaveManager::SaveManager(std::filesystem::path basePath)
-    : basePath_{std::move(basePath)} {}
+    : basePath_{std::move(basePath)},
+      workerThreads_{core::DefaultThreadCount()} {}
 
 void SaveManager::ensureDirectories() const {
     std::filesystem::create_directories(charactersDir());
@@ -109,23 +537,36 @@ std::filesystem::path SaveManager::worldsDir() const {
     return basePath_ / "worlds";
 }
 
+std::filesystem::path SaveManager::mapsDir(const std::string& characterId) const {
+    return basePath_ / "maps" / characterId;
+}
+
+std::filesystem::path SaveManager::editLogDir() const {
+    return basePath_ / "logs";
+}
+
+std::filesystem::path SaveManager::indexPath() const {
+    return basePath_ / "index.bin";
+}
+
 std::vector<CharacterInfo> SaveManager::listCharacters() const {
     std::vector<CharacterInfo> result;
     if (!std::filesystem::exists(charactersDir())) {
         return result;
     }
-    for (const auto& entry : std::filesystem::directory_iterator(charactersDir())) {
-        if (!entry.is_regular_file()) {
-            continue;
-        }
-        const auto path = entry.path();
-        if (path.extension() != ".char") {
-            continue;
-        }
-        CharacterInfo info{};
-        if (readCharacterHeader(path, info)) {
-            result.push_back(info);
-        }
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    loadIndex();
+    const std::int64_t dirModified = modifiedTime(charactersDir());
+    if (dirModified != index_.charactersDirModified) {
+        index_.characters = rescanDirectory(charactersDir(), ".char", index_.characters,
+                                            [this](const std::filesystem::path& path, CharacterInfo& info) {
+                                                return readCharacterHeader(path, info);
+                                            });
+        index_.charactersDirModified = dirModified;
+        writeIndex();
+    }
+    for (const auto& entry : index_.characters) {
+        result.push_back(entry.info);
     }
     std::sort(result.begin(), result.end(), [](const CharacterInfo& a, const CharacterInfo& b) { return a.name < b.name; });
     return result;
@@ -136,21 +577,158 @@ std::vector<WorldInfo> SaveManager::listWorlds() const {
     if (!std::filesystem::exists(worldsDir())) {
         return result;
     }
-    for (const auto& entry : std::filesystem::directory_iterator(worldsDir())) {
-        if (!entry.is_regular_file()) {
-            continue;
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    loadIndex();
+    const std::int64_t dirModified = modifiedTime(worldsDir());
+    if (dirModified != index_.worldsDirModified) {
+        index_.worlds = rescanDirectory(worldsDir(), ".world", index_.worlds,
+                                        [this](const std::filesystem::path& path, WorldInfo& info) {
+                                            return readWorldHeader(path, info);
+                                        });
+        index_.worldsDirModified = dirModified;
+        writeIndex();
+    }
+    for (const auto& entry : index_.worlds) {
+        result.push_back(entry.info);
+    }
+    std::sort(result.begin(), result.end(), [](const WorldInfo& a, const WorldInfo& b) { return a.name < b.name; });
+    return result;
+}
+
+void SaveManager::loadIndex() const {
+    if (index_.loaded) {
+        return;
+    }
+    index_ = SaveIndex{};
+    index_.loaded = true;
+    std::ifstream in(indexPath(), std::ios::binary);
+    if (!in || !readMagic(in, "SIDX")) {
+        return;
+    }
+    std::uint16_t version = 0;
+    if (!readValue(in, version) || version != kIndexVersion) {
+        return;
+    }
+    SaveIndex loaded{};
+    loaded.loaded = true;
+    std::uint32_t count = 0;
+    if (!readValue(in, loaded.charactersDirModified) || !readValue(in, count)) {
+        return;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        IndexedCharacter entry{};
+        std::int32_t health = 0;
+        if (!readString(in, entry.info.id) || !readValue(in, entry.modified) || !readValue(in, entry.size)
+            || !readString(in, entry.info.name) || !readValue(in, health)) {
+            return;
         }
-        const auto path = entry.path();
-        if (path.extension() != ".world") {
-            continue;
+        entry.info.health = static_cast<int>(health);
+        for (auto& armor : entry.info.armor) {
+            std::uint8_t value = 0;
+            if (!readValue(in, value)) {
+                return;
+            }
+            armor = static_cast<entities::ArmorId>(value);
         }
-        WorldInfo info{};
-        if (readWorldHeader(path, info)) {
-            result.push_back(info);
+        for (auto& accessory : entry.info.accessories) {
+            std::uint8_t value = 0;
+            if (!readValue(in, value)) {
+                return;
+            }
+            accessory = static_cast<entities::AccessoryId>(value);
         }
+        loaded.characters.push_back(entry);
     }
-    std::sort(result.begin(), result.end(), [](const WorldInfo& a, const WorldInfo& b) { return a.name < b.name; });
-    return result;
+    if (!readValue(in, loaded.worldsDirModified) || !readValue(in, count)) {
+        return;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        IndexedWorld entry{};
+        if (!readString(in, entry.info.id) || !readValue(in, entry.modified) || !readValue(in, entry.size)
+            || !readString(in, entry.info.name) || !readValue(in, entry.info.width) || !readValue(in, entry.info.height)
+            || !readValue(in, entry.info.seed) || !readValue(in, entry.info.spawnX) || !readValue(in, entry.info.spawnY)) {
+            return;
+        }
+        loaded.worlds.push_back(entry);
+    }
+    index_ = std::move(loaded);
+}
+
+void SaveManager::writeIndex() const {
+    const auto path = indexPath();
+    const auto tempPath = tempPathFor(path);
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return;
+    }
+    writeMagic(out, "SIDX");
+    writeValue(out, kIndexVersion);
+    writeValue(out, index_.charactersDirModified);
+    writeValue(out, static_cast<std::uint32_t>(index_.characters.size()));
+    for (const auto& entry : index_.characters) {
+        writeString(out, entry.info.id);
+        writeValue(out, entry.modified);
+        writeValue(out, entry.size);
+        writeString(out, entry.info.name);
+        writeValue(out, static_cast<std::int32_t>(entry.info.health));
+        for (const auto armor : entry.info.armor) {
+            writeValue(out, static_cast<std::uint8_t>(armor));
+        }
+        for (const auto accessory : entry.info.accessories) {
+            writeValue(out, static_cast<std::uint8_t>(accessory));
+        }
+    }
+    writeValue(out, index_.worldsDirModified);
+    writeValue(out, static_cast<std::uint32_t>(index_.worlds.size()));
+    for (const auto& entry : index_.worlds) {
+        writeString(out, entry.info.id);
+        writeValue(out, entry.modified);
+        writeValue(out, entry.size);
+        writeString(out, entry.info.name);
+        writeValue(out, entry.info.width);
+        writeValue(out, entry.info.height);
+        writeValue(out, entry.info.seed);
+        writeValue(out, entry.info.spawnX);
+        writeValue(out, entry.info.spawnY);
+    }
+    out.close();
+    if (out) {
+        commitTempFile(tempPath, path);
+    }
+}
+
+void SaveManager::indexCharacter(const std::filesystem::path& path, std::int64_t dirModifiedBefore) const {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    loadIndex();
+    IndexedCharacter entry{};
+    if (!readCharacterHeader(path, entry.info)) {
+        return;
+    }
+    entry.modified = modifiedTime(path);
+    entry.size = fileSize(path);
+    const bool wasCurrent = index_.charactersDirModified == dirModifiedBefore;
+    upsertEntry(index_.characters, entry);
+    if (wasCurrent) {
+        index_.charactersDirModified = modifiedTime(charactersDir());
+    }
+    writeIndex();
+}
+
+void SaveManager::indexWorld(const std::filesystem::path& path, std::int64_t dirModifiedBefore) const {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    loadIndex();
+    IndexedWorld entry{};
+    if (!readWorldHeader(path, entry.info)) {
+        return;
+    }
+    entry.modified = modifiedTime(path);
+    entry.size = fileSize(path);
+    const bool wasCurrent = index_.worldsDirModified == dirModifiedBefore;
+    upsertEntry(index_.worlds, entry);
+    if (wasCurrent) {
+        index_.worldsDirModified = modifiedTime(worldsDir());
+    }
+    writeIndex();
 }
 
 bool SaveManager::readCharacterHeader(const std::filesystem::path& path, CharacterInfo& info) const {
@@ -159,7 +737,7 @@ bool SaveManager::readCharacterHeader(const std::filesystem::path& path, Charact
         return false;
     }
     std::uint16_t version = 0;
-    if (!readValue(in, version) || version != kSaveVersion) {
+    if (!readValue(in, version) || !supportedCharacterVersion(version)) {
         return false;
     }
     if (!readString(in, info.name)) {
@@ -205,7 +783,7 @@ bool SaveManager::readWorldHeader(const std::filesystem::path& path, WorldInfo&
         return false;
     }
     std::uint16_t version = 0;
-    if (!readValue(in, version) || version != kSaveVersion) {
+    if (!readValue(in, version) || !supportedWorldVersion(version)) {
         return false;
     }
     if (!readString(in, info.name)) {
@@ -221,15 +799,36 @@ bool SaveManager::readWorldHeader(const std::filesystem::path& path, WorldInfo&
     return true;
 }
 
+bool SaveManager::commitTempFile(const std::filesystem::path& tempPath, const std::filesystem::path& path) const {
+    std::error_code ec;
+    if (!syncPath(tempPath, false)) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    syncPath(path.parent_path(), true);
+    return true;
+}
+
 bool SaveManager::saveCharacter(const std::string& id, const std::string& name, const entities::Player& player) const {
+    TERRARIA_TRACE_ZONE("save.character");
     ensureDirectories();
+    if (!saveExploredMaps(id, player)) {
+        return false;
+    }
     const auto path = charactersDir() / (id + ".char");
-    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const auto tempPath = tempPathFor(path);
+    const std::int64_t dirModified = modifiedTime(charactersDir());
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
     if (!out) {
         return false;
     }
     writeMagic(out, "CHAR");
-    writeValue(out, kSaveVersion);
+    writeValue(out, kCharacterVersion);
     writeString(out, name);
     writeValue(out, player.position().x);
     writeValue(out, player.position().y);
@@ -245,34 +844,26 @@ bool SaveManager::saveCharacter(const std::string& id, const std::string& name,
     for (int i = 0; i < entities::kAccessorySlotCount; ++i) {
         writeValue(out, static_cast<std::uint8_t>(player.accessoryAt(i)));
     }
-    const auto& exploredMaps = player.exploredMaps();
-    const std::uint16_t mapCount = static_cast<std::uint16_t>(std::min<std::size_t>(exploredMaps.size(), 65000));
-    writeValue(out, mapCount);
-    std::uint16_t written = 0;
-    for (const auto& entry : exploredMaps) {
-        if (written >= mapCount) {
-            break;
-        }
-        writeString(out, entry.first);
-        writeValue(out, static_cast<std::int32_t>(entry.second.width));
-        writeValue(out, static_cast<std::int32_t>(entry.second.height));
-        const auto& data = entry.second.data;
-        for (std::uint8_t value : data) {
-            writeValue(out, value);
-        }
-        ++written;
+    out.close();
+    if (!out) {
+        return false;
     }
-    return static_cast<bool>(out);
+    if (!commitTempFile(tempPath, path)) {
+        return false;
+    }
+    indexCharacter(path, dirModified);
+    return true;
 }
 
 bool SaveManager::loadCharacter(const std::string& id, entities::Player& player, std::string& outName) const {
+    TERRARIA_TRACE_ZONE("load.character");
     const auto path = charactersDir() / (id + ".char");
     std::ifstream in(path, std::ios::binary);
     if (!in || !readMagic(in, "CHAR")) {
         return false;
     }
     std::uint16_t version = 0;
-    if (!readValue(in, version) || version != kSaveVersion) {
+    if (!readValue(in, version) || !supportedCharacterVersion(version)) {
         return false;
     }
     if (!readString(in, outName)) {
@@ -313,6 +904,10 @@ bool SaveManager::loadCharacter(const std::string& id, entities::Player& player,
         player.equipAccessory(i, static_cast<entities::AccessoryId>(accessoryId));
     }
     player.clearExploredMaps();
+    if (version != kEmbeddedMapsCharacterVersion) {
+        player.setHealth(static_cast<int>(health));
+        return true;
+    }
     std::uint16_t mapCount = 0;
     if (!readValue(in, mapCount)) {
         return false;
@@ -330,105 +925,321 @@ bool SaveManager::loadCharacter(const std::string& id, entities::Player& player,
         if (width <= 0 || height <= 0) {
             continue;
         }
-        entities::Player::MapExploration map{};
-        map.width = width;
-        map.height = height;
-        map.data.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
-        for (std::size_t idx = 0; idx < map.data.size(); ++idx) {
-            std::uint8_t exploredValue = 0;
-            if (!readValue(in, exploredValue)) {
+        std::vector<std::uint8_t> dense(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+        for (std::size_t idx = 0; idx < dense.size(); ++idx) {
+            if (!readValue(in, dense[idx])) {
                 return false;
             }
-            map.data[idx] = exploredValue;
         }
+        MapExploration map = tiledFromDense(width, height, dense);
+        map.revision = 1;
         player.setExploredMap(worldId, std::move(map));
     }
     player.setHealth(static_cast<int>(health));
     return true;
 }
 
+bool SaveManager::loadExploredMap(const std::string& characterId, const std::string& mapKey, entities::Player& player) const {
+    TERRARIA_TRACE_ZONE("load.exploredMap");
+    if (characterId.empty() || mapKey.empty()) {
+        return false;
+    }
+    std::ifstream in(mapsDir(characterId) / (mapKey + ".map"), std::ios::binary);
+    if (!in || !readMagic(in, "EMAP")) {
+        return false;
+    }
+    std::uint16_t version = 0;
+    if (!readValue(in, version) || (version != kExploredMapVersion && version != kDenseExploredMapVersion)) {
+        return false;
+    }
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+    if (!readValue(in, width) || !readValue(in, height) || width <= 0 || height <= 0) {
+        return false;
+    }
+    MapExploration map{};
+    if (version == kDenseExploredMapVersion) {
+        std::vector<std::uint8_t> dense(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+        if (!readRuns(in, dense)) {
+            return false;
+        }
+        map = tiledFromDense(width, height, dense);
+        map.revision = 1;
+    } else {
+        std::int32_t tileSize = 0;
+        if (!readValue(in, tileSize) || tileSize != MapExploration::kTileSize) {
+            return false;
+        }
+        map.reset(width, height);
+        for (std::size_t tile = 0; tile < map.uniform.size(); ++tile) {
+            std::uint8_t kind = 0;
+            if (!readValue(in, kind)) {
+                return false;
+            }
+            if (kind == kMapTileUniform) {
+                if (!readValue(in, map.uniform[tile])) {
+                    return false;
+                }
+                continue;
+            }
+            auto& cells = map.detail[tile];
+            cells.resize(static_cast<std::size_t>(MapExploration::kTileCells));
+            if (kind != kMapTileDetail || !readRuns(in, cells)) {
+                return false;
+            }
+            map.fullCount[tile] = static_cast<std::uint16_t>(std::count(cells.begin(), cells.end(), 255));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mapMutex_);
+        savedMapRevisions_[mapRevisionKey(characterId, mapKey)] = map.revision;
+    }
+    player.setExploredMap(mapKey, std::move(map));
+    return true;
+}
+
+bool SaveManager::saveExploredMaps(const std::string& characterId, const entities::Player& player) const {
+    TERRARIA_TRACE_ZONE("save.exploredMaps");
+    std::lock_guard<std::mutex> lock(mapMutex_);
+    for (const auto& [mapKey, map] : player.exploredMaps()) {
+        if (map.empty()) {
+            continue;
+        }
+        const std::string revisionKey = mapRevisionKey(characterId, mapKey);
+        const auto saved = savedMapRevisions_.find(revisionKey);
+        if (saved != savedMapRevisions_.end() && saved->second == map.revision) {
+            continue;
+        }
+        const auto dir = mapsDir(characterId);
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        const auto path = dir / (mapKey + ".map");
+        const auto tempPath = tempPathFor(path);
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        writeMagic(out, "EMAP");
+        writeValue(out, kExploredMapVersion);
+        writeValue(out, static_cast<std::int32_t>(map.width));
+        writeValue(out, static_cast<std::int32_t>(map.height));
+        writeValue(out, static_cast<std::int32_t>(MapExploration::kTileSize));
+        for (std::size_t tile = 0; tile < map.uniform.size(); ++tile) {
+            if (map.detail[tile].empty()) {
+                writeValue(out, kMapTileUniform);
+                writeValue(out, map.uniform[tile]);
+            } else {
+                writeValue(out, kMapTileDetail);
+                writeRuns(out, map.detail[tile]);
+            }
+        }
+        out.close();
+        if (!out || !commitTempFile(tempPath, path)) {
+            return false;
+        }
+        savedMapRevisions_[revisionKey] = map.revision;
+    }
+    return true;
+}
+
+WorldSnapshot SaveManager::snapshotWorld(const std::string& id,
+                                         const std::string& name,
+                                         const world::World& world,
+                                         std::uint32_t seed,
+                                         const world::WorldGenerator::WorldGenConfig& genConfig,
+                                         float spawnX,
+                                         float spawnY,
+                                         float timeOfDay,
+                                         bool isNight) {
+    TERRARIA_TRACE_ZONE("save.snapshotWorld");
+    WorldSnapshot snapshot{};
+    snapshot.id = id;
+    snapshot.name = name;
+    snapshot.width = world.width();
+    snapshot.height = world.height();
+    snapshot.seed = seed;
+    snapshot.genConfig = genConfig;
+    snapshot.spawnX = spawnX;
+    snapshot.spawnY = spawnY;
+    snapshot.timeOfDay = timeOfDay;
+    snapshot.isNight = isNight;
+    snapshot.tiles.assign(world.cells(), world.cells() + world.cellCount());
+    snapshot.chunkHashes = world.chunkHashes();
+    return snapshot;
+}
+
 bool SaveManager::saveWorld(const std::string& id,
                             const std::string& name,
                             const world::World& world,
                             std::uint32_t seed,
+                            const world::WorldGenerator::WorldGenConfig& genConfig,
                             float spawnX,
                             float spawnY,
                             float timeOfDay,
                             bool isNight) const {
+    return saveWorld(snapshotWorld(id, name, world, seed, genConfig, spawnX, spawnY, timeOfDay, isNight));
+}
+
+std::shared_ptr<const SaveBuffer> SaveManager::generatedBaseline(
+    int width,
+    int height,
+    std::uint32_t seed,
+    const world::WorldGenerator::WorldGenConfig& genConfig) const {
+    std::lock_guard<std::mutex> lock(baselineMutex_);
+    if (baseline_.cells && baseline_.width == width && baseline_.height == height && baseline_.seed == seed
+        && sameGenConfig(baseline_.genConfig, genConfig)) {
+        return baseline_.cells;
+    }
+    world::World generated(width, height);
+    world::WorldGenerator generator;
+    generator.generate(generated, seed, genConfig);
+    baseline_.width = width;
+    baseline_.height = height;
+    baseline_.seed = seed;
+    baseline_.genConfig = genConfig;
+    baseline_.cells = std::make_shared<const SaveBuffer>(generated.cells(),
+                                                                        generated.cells() + generated.cellCount());
+    return baseline_.cells;
+}
+
+bool SaveManager::saveWorld(const WorldSnapshot& snapshot) const {
+    TERRARIA_TRACE_ZONE("save.world");
     ensureDirectories();
-    const auto path = worldsDir() / (id + ".world");
-    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const auto path = worldsDir() / (snapshot.id + ".world");
+    const auto tempPath = tempPathFor(path);
+    const std::int64_t dirModified = modifiedTime(worldsDir());
+    if (snapshot.tiles.size() != world::World::cellCountFor(snapshot.width, snapshot.height)
+        || snapshot.chunkHashes.size() != snapshot.tiles.size() / world::World::kChunkArea) {
+        return false;
+    }
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
     if (!out) {
         return false;
     }
     writeMagic(out, "WLD1");
-    writeValue(out, kSaveVersion);
-    writeString(out, name);
-    writeValue(out, world.width());
-    writeValue(out, world.height());
-    writeValue(out, seed);
-    writeValue(out, spawnX);
-    writeValue(out, spawnY);
-    writeValue(out, timeOfDay);
-    writeValue(out, static_cast<std::uint8_t>(isNight ? 1 : 0));
-    for (int y = 0; y < world.height(); ++y) {
-        for (int x = 0; x < world.width(); ++x) {
-            const auto& tile = world.tile(x, y);
-            writeValue(out, static_cast<std::uint8_t>(tile.type()));
-            writeValue(out, static_cast<std::uint8_t>(tile.active() ? 1 : 0));
+    writeValue(out, kWorldVersion);
+    writeString(out, snapshot.name);
+    writeValue(out, snapshot.width);
+    writeValue(out, snapshot.height);
+    writeValue(out, snapshot.seed);
+    writeValue(out, snapshot.spawnX);
+    writeValue(out, snapshot.spawnY);
+    writeValue(out, snapshot.timeOfDay);
+    writeValue(out, static_cast<std::uint8_t>(snapshot.isNight ? 1 : 0));
+    writeValue(out, world::WorldGenerator::kVersion);
+    writeGenConfig(out, snapshot.genConfig);
+    writeValue(out, static_cast<std::uint32_t>(world::World::kChunkSize));
+    writeValue(out, static_cast<std::uint8_t>(worldEncoding_));
+    writeChunkHashes(out, snapshot.chunkHashes);
+    if (worldEncoding_ == WorldEncoding::Delta) {
+        const auto baseline = generatedBaseline(snapshot.width, snapshot.height, snapshot.seed, snapshot.genConfig);
+        const std::size_t chunkCount = snapshot.tiles.size() / world::World::kChunkArea;
+        std::vector<std::uint32_t> changed;
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            const auto begin = static_cast<std::ptrdiff_t>(chunk * world::World::kChunkArea);
+            const auto end = begin + static_cast<std::ptrdiff_t>(world::World::kChunkArea);
+            if (!std::equal(snapshot.tiles.begin() + begin, snapshot.tiles.begin() + end, baseline->begin() + begin)) {
+                changed.push_back(static_cast<std::uint32_t>(chunk));
+            }
         }
+        writeValue(out, static_cast<std::uint32_t>(changed.size()));
+        for (const std::uint32_t chunk : changed) {
+            writeValue(out, chunk);
+            out.write(reinterpret_cast<const char*>(snapshot.tiles.data() + chunk * world::World::kChunkArea),
+                      static_cast<std::streamsize>(world::World::kChunkArea));
+        }
+    } else if (worldEncoding_ == WorldEncoding::Blocks) {
+        const std::size_t chunkCount = snapshot.tiles.size() / world::World::kChunkArea;
+        const std::size_t blockCount = (chunkCount + kBlockChunks - 1) / kBlockChunks;
+        const std::size_t blockBytes = kBlockChunks * world::World::kChunkArea;
+        std::vector<SaveBuffer> blocks(blockCount);
+        core::ParallelFor(blockCount, workerThreads_, [&](std::size_t block) {
+            const std::size_t begin = block * blockBytes;
+            const std::size_t size = std::min(blockBytes, snapshot.tiles.size() - begin);
+            encodeRunsInto(snapshot.tiles.data() + begin, size, blocks[block]);
+        });
+        writeValue(out, kBlockChunks);
+        writeValue(out, static_cast<std::uint32_t>(blockCount));
+        for (const auto& block : blocks) {
+            writeValue(out, static_cast<std::uint32_t>(block.size()));
+        }
+        for (const auto& block : blocks) {
+            out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+        }
+    } else {
+        const auto headerEnd = static_cast<std::uint64_t>(out.tellp()) + sizeof(std::uint64_t);
+        const std::uint64_t dataOffset = (headerEnd + kWorldDataAlignment - 1) / kWorldDataAlignment * kWorldDataAlignment;
+        writeValue(out, dataOffset);
+        const std::vector<char> padding(static_cast<std::size_t>(dataOffset - headerEnd), 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(reinterpret_cast<const char*>(snapshot.tiles.data()), static_cast<std::streamsize>(snapshot.tiles.size()));
+    }
+    out.close();
+    if (!out) {
+        return false;
     }
-    return static_cast<bool>(out);
+    if (!commitTempFile(tempPath, path)) {
+        return false;
+    }
+    indexWorld(path, dirModified);
+    return true;
 }
 
 bool SaveManager::loadWorld(const std::string& id,
                             world::World& world,
                             std::string& outName,
                             std::uint32_t& seed,
+                            world::WorldGenerator::WorldGenConfig& genConfig,
                             float& spawnX,
                             float& spawnY,
                             float& timeOfDay,
                             bool& isNight) const {
-    const auto path = worldsDir() / (id + ".world");
-    std::ifstream in(path, std::ios::binary);
-    if (!in || !readMagic(in, "WLD1")) {
-        return false;
-    }
-    std::uint16_t version = 0;
-    if (!readValue(in, version) || version != kSaveVersion) {
+    TERRARIA_TRACE_ZONE("load.world");
+    WorldFile file{};
+    if (!readWorldFile(worldsDir() / (id + ".world"), file, world, workerThreads_)) {
         return false;
     }
-    if (!readString(in, outName)) {
-        return false;
-    }
-    int width = 0;
-    int height = 0;
-    if (!readValue(in, width) || !readValue(in, height)) {
+    outName = file.name;
+    seed = file.seed;
+    genConfig = file.genConfig;
+    spawnX = file.spawnX;
+    spawnY = file.spawnY;
+    timeOfDay = file.timeOfDay;
+    isNight = file.isNight;
+    return true;
+}
+
+bool SaveManager::verifyWorld(const std::string& id, std::vector<std::size_t>& mismatchedChunks) const {
+    mismatchedChunks.clear();
+    WorldFile file{};
+    world::World world(1, 1);
+    if (!readWorldFile(worldsDir() / (id + ".world"), file, world, workerThreads_) || file.chunkHashes.empty()) {
         return false;
     }
-    if (!readValue(in, seed) || !readValue(in, spawnX) || !readValue(in, spawnY)) {
-        return false;
+    std::vector<std::uint64_t> actual(world.chunkCount());
+    core::ParallelFor(actual.size(), workerThreads_, [&](std::size_t chunk) {
+        actual[chunk] = world::ChunkHash(world.chunkCells(chunk));
+    });
+    for (std::size_t chunk = 0; chunk < actual.size(); ++chunk) {
+        if (actual[chunk] != file.chunkHashes[chunk]) {
+            mismatchedChunks.push_back(chunk);
+        }
     }
-    float loadedTime = 0.0F;
-    std::uint8_t nightFlag = 0;
-    if (!readValue(in, loadedTime) || !readValue(in, nightFlag)) {
+    return mismatchedChunks.empty();
+}
+
+bool SaveManager::readChunkHashes(const std::filesystem::path& path,
+                                  int& width,
+                                  int& height,
+                                  std::vector<std::uint64_t>& hashes) {
+    std::ifstream in(path, std::ios::binary);
+    WorldFile file{};
+    if (!in || !readWorldPrelude(in, file) || file.chunkHashes.empty()) {
         return false;
     }
-    if (width != world.width() || height != world.height()) {
-        world = world::World(width, height);
-    }
-    for (int y = 0; y < world.height(); ++y) {
-        for (int x = 0; x < world.width(); ++x) {
-            std::uint8_t typeValue = 0;
-            std::uint8_t activeValue = 0;
-            if (!readValue(in, typeValue) || !readValue(in, activeValue)) {
-                return false;
-            }
-            world.setTile(x, y, static_cast<world::TileType>(typeValue), activeValue != 0);
-        }
-    }
-    timeOfDay = loadedTime;
-    isNight = nightFlag != 0;
+    width = file.width;
+    height = file.height;
+    hashes = std::move(file.chunkHashes);
     return true;
 }
 
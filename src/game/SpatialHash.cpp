@@ -0,0 +1,194 @@
+#include "terraria/game/SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace terraria::game {
+
+namespace {
+bool inMask(const Collider& collider, ColliderMask mask) {
+    return (mask & ColliderBit(collider.kind)) != 0;
+}
+
+// Open-interval slab test of p(t) = start + t * delta, t in [0, 1], against (lo, hi).
+bool slab(float start, float delta, float lo, float hi, float& enter, float& exit) {
+    if (delta == 0.0F) {
+        return start > lo && start < hi;
+    }
+    float t0 = (lo - start) / delta;
+    float t1 = (hi - start) / delta;
+    if (t0 > t1) {
+        std::swap(t0, t1);
+    }
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+    return enter < exit;
+}
+} // namespace
+
+SpatialHash::SpatialHash(float cellSize)
+    : cellSize_{cellSize},
+      inverseCellSize_{1.0F / cellSize} {}
+
+void SpatialHash::clear() {
+    colliders_.clear();
+    entries_.clear();
+}
+
+int SpatialHash::insert(ColliderKind kind, int index, const entities::Vec2& position, float halfWidth, float height) {
+    const int id = static_cast<int>(colliders_.size());
+    colliders_.push_back({kind, index, position.x - halfWidth, position.y - height, position.x + halfWidth, position.y});
+    return id;
+}
+
+void SpatialHash::build() {
+    scratch_.clear();
+    for (std::size_t id = 0; id < colliders_.size(); ++id) {
+        const Collider& collider = colliders_[id];
+        const int x0 = cellOf(collider.left);
+        const int x1 = cellOf(collider.right);
+        const int y0 = cellOf(collider.top);
+        const int y1 = cellOf(collider.bottom);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                scratch_.push_back({cellKey(x, y), static_cast<int>(id)});
+            }
+        }
+    }
+
+    // At least twice as many buckets as entries keeps unrelated cells sharing a bucket rare.
+    int bits = 4;
+    while ((std::size_t{1} << bits) < scratch_.size() * 2) {
+        ++bits;
+    }
+    bucketShift_ = 64 - bits;
+    const std::size_t buckets = std::size_t{1} << bits;
+    bucketStart_.assign(buckets + 1, 0);
+    for (const CellEntry& entry : scratch_) {
+        ++bucketStart_[bucketOf(entry.cell) + 1];
+    }
+    for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+        bucketStart_[bucket + 1] += bucketStart_[bucket];
+    }
+    // Scattering in collider order keeps each bucket ascending by collider. The starts double as write
+    // cursors, which leaves each one at the next bucket's start, so they are shifted back afterwards.
+    entries_.resize(scratch_.size());
+    for (const CellEntry& entry : scratch_) {
+        entries_[bucketStart_[bucketOf(entry.cell)]++] = entry;
+    }
+    for (std::size_t bucket = buckets; bucket > 0; --bucket) {
+        bucketStart_[bucket] = bucketStart_[bucket - 1];
+    }
+    bucketStart_[0] = 0;
+    visited_.assign(colliders_.size(), 0);
+    queryStamp_ = 0;
+}
+
+int SpatialHash::cellOf(float coordinate) const {
+    return static_cast<int>(std::floor(coordinate * inverseCellSize_));
+}
+
+std::size_t SpatialHash::bucketOf(std::int64_t key) const {
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> bucketShift_);
+}
+
+std::int64_t SpatialHash::cellKey(int cellX, int cellY) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(static_cast<std::uint32_t>(cellY)) << 32
+                                     | static_cast<std::uint32_t>(cellX));
+}
+
+template <typename Visit>
+void SpatialHash::forEachCandidate(float left, float top, float right, float bottom, ColliderMask mask, Visit&& visit) const {
+    if (entries_.empty()) {
+        return;
+    }
+    if (++queryStamp_ == 0) {
+        std::fill(visited_.begin(), visited_.end(), 0);
+        queryStamp_ = 1;
+    }
+    const int x0 = cellOf(left);
+    const int x1 = cellOf(right);
+    const int y0 = cellOf(top);
+    const int y1 = cellOf(bottom);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            const std::int64_t key = cellKey(x, y);
+            const std::size_t bucket = bucketOf(key);
+            for (std::uint32_t i = bucketStart_[bucket]; i < bucketStart_[bucket + 1]; ++i) {
+                const CellEntry& entry = entries_[i];
+                if (entry.cell != key) {
+                    continue;
+                }
+                std::uint32_t& seen = visited_[static_cast<std::size_t>(entry.collider)];
+                if (seen == queryStamp_) {
+                    continue;
+                }
+                seen = queryStamp_;
+                if (inMask(colliders_[static_cast<std::size_t>(entry.collider)], mask)) {
+                    visit(entry.collider);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::queryBox(const entities::Vec2& position,
+                           float halfWidth,
+                           float height,
+                           ColliderMask mask,
+                           std::vector<int>& out) const {
+    out.clear();
+    const float left = position.x - halfWidth;
+    const float right = position.x + halfWidth;
+    const float top = position.y - height;
+    const float bottom = position.y;
+    forEachCandidate(left, top, right, bottom, mask, [&](int id) {
+        const Collider& c = colliders_[static_cast<std::size_t>(id)];
+        if (right > c.left && left < c.right && bottom > c.top && top < c.bottom) {
+            out.push_back(id);
+        }
+    });
+    std::sort(out.begin(), out.end());
+}
+
+void SpatialHash::queryCircle(const entities::Vec2& center, float radius, ColliderMask mask, std::vector<int>& out) const {
+    out.clear();
+    forEachCandidate(center.x - radius, center.y - radius, center.x + radius, center.y + radius, mask, [&](int id) {
+        const Collider& c = colliders_[static_cast<std::size_t>(id)];
+        const float dx = center.x - std::clamp(center.x, c.left, c.right);
+        const float dy = center.y - std::clamp(center.y, c.top, c.bottom);
+        if (dx * dx + dy * dy < radius * radius) {
+            out.push_back(id);
+        }
+    });
+    std::sort(out.begin(), out.end());
+}
+
+void SpatialHash::querySegment(const entities::Vec2& from,
+                               const entities::Vec2& to,
+                               float halfWidth,
+                               float height,
+                               ColliderMask mask,
+                               std::vector<SegmentHit>& out) const {
+    out.clear();
+    const float left = std::min(from.x, to.x) - halfWidth;
+    const float right = std::max(from.x, to.x) + halfWidth;
+    const float top = std::min(from.y, to.y) - height;
+    const float bottom = std::max(from.y, to.y);
+    const entities::Vec2 delta{to.x - from.x, to.y - from.y};
+    forEachCandidate(left, top, right, bottom, mask, [&](int id) {
+        const Collider& c = colliders_[static_cast<std::size_t>(id)];
+        // The moving box overlaps c exactly when its anchor lies inside c grown by the box.
+        float enter = 0.0F;
+        float exit = 1.0F;
+        if (slab(from.x, delta.x, c.left - halfWidth, c.right + halfWidth, enter, exit)
+            && slab(from.y, delta.y, c.top, c.bottom + height, enter, exit)) {
+            out.push_back({id, enter});
+        }
+    });
+    std::sort(out.begin(), out.end(), [](const SegmentHit& a, const SegmentHit& b) {
+        return a.time != b.time ? a.time < b.time : a.collider < b.collider;
+    });
+}
+
+} // namespace terraria::game
@@ -0,0 +1,249 @@
+#include "terraria/input/InputRecording.h"
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+namespace terraria::input {
+
+namespace {
+
+constexpr std::uint32_t kRecordingMagic = 0x4E495254; // "TRIN"
+constexpr std::uint16_t kRecordingVersion = 2; // 2: sessions autostart on a generated world
+
+constexpr std::array<bool InputState::*, 25> kButtons{
+    &InputState::jump,          &InputState::breakHeld,        &InputState::placeHeld,
+    &InputState::toggleCamera,  &InputState::craftPrev,        &InputState::craftNext,
+    &InputState::craftExecute,  &InputState::inventoryToggle,  &InputState::inventoryClick,
+    &InputState::inventoryRightClick, &InputState::consoleToggle, &InputState::consoleSlash,
+    &InputState::consoleSubmit, &InputState::consoleBackspace, &InputState::consoleLeft,
+    &InputState::consoleRight,  &InputState::menuUp,           &InputState::menuDown,
+    &InputState::menuSelect,    &InputState::menuBack,         &InputState::minimapZoomIn,
+    &InputState::minimapZoomOut, &InputState::minimapToggle,   &InputState::minimapDrag,
+    &InputState::perfToggle};
+constexpr std::array<float InputState::*, 3> kAxes{&InputState::moveX, &InputState::camMoveX, &InputState::camMoveY};
+constexpr std::array<int InputState::*, 5> kValues{
+    &InputState::mouseX, &InputState::mouseY, &InputState::hotbarSelection, &InputState::mouseDeltaX, &InputState::mouseDeltaY};
+
+// Frame change mask: bit 0 buttons, then one bit per axis, one per value, and the text last.
+constexpr std::uint16_t kButtonsChanged = 1U << 0;
+constexpr unsigned kFirstAxisBit = 1;
+constexpr unsigned kFirstValueBit = kFirstAxisBit + kAxes.size();
+constexpr std::uint16_t kTextChanged = 1U << (kFirstValueBit + kValues.size());
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+std::uint32_t packButtons(const InputState& state) {
+    std::uint32_t bits = 0;
+    for (std::size_t i = 0; i < kButtons.size(); ++i) {
+        if (state.*kButtons[i]) {
+            bits |= 1U << i;
+        }
+    }
+    return bits;
+}
+
+void writeFrame(std::ostream& out, const InputState& previous, const InputState& current) {
+    std::uint16_t mask = 0;
+    const std::uint32_t buttons = packButtons(current);
+    if (buttons != packButtons(previous)) {
+        mask |= kButtonsChanged;
+    }
+    for (std::size_t i = 0; i < kAxes.size(); ++i) {
+        if (current.*kAxes[i] != previous.*kAxes[i]) {
+            mask |= static_cast<std::uint16_t>(1U << (kFirstAxisBit + i));
+        }
+    }
+    for (std::size_t i = 0; i < kValues.size(); ++i) {
+        if (current.*kValues[i] != previous.*kValues[i]) {
+            mask |= static_cast<std::uint16_t>(1U << (kFirstValueBit + i));
+        }
+    }
+    if (current.textInput != previous.textInput) {
+        mask |= kTextChanged;
+    }
+
+    writeValue(out, mask);
+    if ((mask & kButtonsChanged) != 0) {
+        writeValue(out, buttons);
+    }
+    for (std::size_t i = 0; i < kAxes.size(); ++i) {
+        if ((mask & (1U << (kFirstAxisBit + i))) != 0) {
+            writeValue(out, current.*kAxes[i]);
+        }
+    }
+    for (std::size_t i = 0; i < kValues.size(); ++i) {
+        if ((mask & (1U << (kFirstValueBit + i))) != 0) {
+            writeValue(out, static_cast<std::int32_t>(current.*kValues[i]));
+        }
+    }
+    if ((mask & kTextChanged) != 0) {
+        const auto length = static_cast<std::uint16_t>(current.textInput.size());
+        writeValue(out, length);
+        out.write(current.textInput.data(), length);
+    }
+}
+
+bool readFrame(std::istream& in, InputState& state) {
+    std::uint16_t mask = 0;
+    if (!readValue(in, mask)) {
+        return false;
+    }
+    if ((mask & kButtonsChanged) != 0) {
+        std::uint32_t buttons = 0;
+        if (!readValue(in, buttons)) {
+            return false;
+        }
+        for (std::size_t i = 0; i < kButtons.size(); ++i) {
+            state.*kButtons[i] = (buttons & (1U << i)) != 0;
+        }
+    }
+    for (std::size_t i = 0; i < kAxes.size(); ++i) {
+        if ((mask & (1U << (kFirstAxisBit + i))) != 0 && !readValue(in, state.*kAxes[i])) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < kValues.size(); ++i) {
+        if ((mask & (1U << (kFirstValueBit + i))) != 0) {
+            std::int32_t value = 0;
+            if (!readValue(in, value)) {
+                return false;
+            }
+            state.*kValues[i] = value;
+        }
+    }
+    if ((mask & kTextChanged) != 0) {
+        std::uint16_t length = 0;
+        if (!readValue(in, length)) {
+            return false;
+        }
+        state.textInput.assign(length, '\0');
+        if (length > 0 && !in.read(state.textInput.data(), length)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readHeader(std::istream& in, InputRecordingHeader& header) {
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0;
+    if (!readValue(in, magic) || !readValue(in, version) || magic != kRecordingMagic || version != kRecordingVersion) {
+        return false;
+    }
+    return readValue(in, header.simulationHz) && readValue(in, header.simulationSeed) && readValue(in, header.worldWidth)
+        && readValue(in, header.worldHeight) && readValue(in, header.windowWidth) && readValue(in, header.windowHeight);
+}
+
+class RecordingInputSystem final : public IInputSystem {
+public:
+    RecordingInputSystem(std::unique_ptr<IInputSystem> inner, const std::string& path, const InputRecordingHeader& header)
+        : inner_{std::move(inner)},
+          out_{path, std::ios::binary | std::ios::trunc} {
+        if (!out_) {
+            std::fprintf(stderr, "input recording: cannot open %s\n", path.c_str());
+            return;
+        }
+        writeValue(out_, kRecordingMagic);
+        writeValue(out_, kRecordingVersion);
+        writeValue(out_, header.simulationHz);
+        writeValue(out_, header.simulationSeed);
+        writeValue(out_, header.worldWidth);
+        writeValue(out_, header.worldHeight);
+        writeValue(out_, header.windowWidth);
+        writeValue(out_, header.windowHeight);
+    }
+
+    void initialize() override { inner_->initialize(); }
+
+    void poll() override {
+        inner_->poll();
+        const InputState& current = inner_->state();
+        if (out_) {
+            writeFrame(out_, previous_, current);
+        }
+        previous_ = current;
+    }
+
+    bool shouldQuit() const override { return inner_->shouldQuit(); }
+    const InputState& state() const override { return inner_->state(); }
+
+    void shutdown() override {
+        out_.flush();
+        inner_->shutdown();
+    }
+
+private:
+    std::unique_ptr<IInputSystem> inner_;
+    std::ofstream out_;
+    InputState previous_{};
+};
+
+class ReplayInputSystem final : public IInputSystem {
+public:
+    explicit ReplayInputSystem(const std::string& path) {
+        std::ifstream file{path, std::ios::binary};
+        data_.str(std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}});
+        InputRecordingHeader header{};
+        if (!readHeader(data_, header)) {
+            std::fprintf(stderr, "input replay: %s is not an input recording\n", path.c_str());
+            quit_ = true;
+        }
+    }
+
+    void initialize() override {}
+
+    void poll() override {
+        if (quit_) {
+            return;
+        }
+        if (!readFrame(data_, state_)) {
+            quit_ = true;
+            return;
+        }
+        // Quit alongside the last frame so the replay simulates exactly as many ticks as were recorded.
+        if (data_.peek() == std::char_traits<char>::eof()) {
+            quit_ = true;
+        }
+    }
+
+    bool shouldQuit() const override { return quit_; }
+    const InputState& state() const override { return state_; }
+    void shutdown() override {}
+
+private:
+    std::istringstream data_{};
+    InputState state_{};
+    bool quit_{false};
+};
+
+} // namespace
+
+bool ReadInputRecordingHeader(const std::string& path, InputRecordingHeader& header) {
+    std::ifstream in{path, std::ios::binary};
+    return in && readHeader(in, header);
+}
+
+std::unique_ptr<IInputSystem> CreateRecordingInputSystem(std::unique_ptr<IInputSystem> inner,
+                                                         const std::string& path,
+                                                         const InputRecordingHeader& header) {
+    return std::make_unique<RecordingInputSystem>(std::move(inner), path, header);
+}
+
+std::unique_ptr<IInputSystem> CreateReplayInputSystem(const std::string& path) {
+    return std::make_unique<ReplayInputSystem>(path);
+}
+
+} // namespace terraria::input
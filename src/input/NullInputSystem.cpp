@@ -0,0 +1,25 @@
+#include "terraria/input/InputSystem.h"
+
+namespace terraria::input {
+
+namespace {
+
+class NullInputSystem final : public IInputSystem {
+public:
+    void initialize() override {}
+    void poll() override {}
+    bool shouldQuit() const override { return false; }
+    const InputState& state() const override { return state_; }
+    void shutdown() override {}
+
+private:
+    InputState state_{};
+};
+
+} // namespace
+
+std::unique_ptr<IInputSystem> CreateNullInputSystem() {
+    return std::make_unique<NullInputSystem>();
+}
+
+} // namespace terraria::input
@@ -46,6 +46,7 @@ public:
         state_.minimapZoomOut = false;
         state_.minimapToggle = false;
         state_.minimapDrag = false;
+        state_.perfToggle = false;
         state_.mouseDeltaX = 0;
         state_.mouseDeltaY = 0;
         state_.textInput.clear();
@@ -107,6 +108,9 @@ public:
                 case SDLK_m:
                     state_.minimapToggle = true;
                     break;
+                case SDLK_F3:
+                    state_.perfToggle = true;
+                    break;
                 case SDLK_LEFT:
                     state_.consoleLeft = true;
                     break;
@@ -1,7 +1,16 @@
 #include "terraria/core/Application.h"
+#include "terraria/tools/Commands.h"
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        return terraria::tools::RunCommand(argc, argv);
+    }
+#ifdef TERRARIA_HEADLESS
+    // Nothing to show a menu on: without a command, run the default headless simulation.
+    return terraria::tools::RunSimulateSession({});
+#else
     terraria::core::Application app;
     app.run();
     return 0;
+#endif
 }
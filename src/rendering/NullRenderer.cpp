@@ -0,0 +1,23 @@
+#include "terraria/rendering/Renderer.h"
+
+namespace terraria::rendering {
+
+namespace {
+
+class NullRenderer final : public IRenderer {
+public:
+    void initialize() override {}
+    void render(const world::World&,
+                const entities::Player&,
+                const HudState&,
+                core::FrameArena&) override {}
+    void shutdown() override {}
+};
+
+} // namespace
+
+std::unique_ptr<IRenderer> CreateNullRenderer() {
+    return std::make_unique<NullRenderer>();
+}
+
+} // namespace terraria::rendering
@@ -1,8 +1,13 @@
 #include "terraria/rendering/Renderer.h"
 
 #include "terraria/core/Application.h"
+#include "terraria/core/FrameArena.h"
+#include "terraria/core/MemoryTags.h"
+#include "terraria/core/Trace.h"
 #include "terraria/entities/FlyingEnemy.h"
 #include "terraria/entities/Tools.h"
+#include "terraria/entities/Zombie.h"
+#include "terraria/rendering/Palette.h"
 
 #include <SDL.h>
 
@@ -10,7 +15,9 @@
 #include <array>
 #include <cctype>
 #include <cmath>
+#include <cstdio>
 #include <filesystem>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -24,25 +31,9 @@ namespace {
 constexpr int kTilePixels = 16;
 constexpr float kTwoPi = 6.28318530718F;
 
-SDL_Color TileColor(world::TileType type) {
-    switch (type) {
-    case world::TileType::Dirt: return SDL_Color{126, 86, 59, 255};
-    case world::TileType::Stone: return SDL_Color{100, 100, 100, 255};
-    case world::TileType::Grass: return SDL_Color{50, 160, 60, 255};
-    case world::TileType::CopperOre: return SDL_Color{220, 140, 80, 255};
-    case world::TileType::IronOre: return SDL_Color{150, 165, 185, 255};
-    case world::TileType::GoldOre: return SDL_Color{252, 205, 40, 255};
-    case world::TileType::Arrow: return SDL_Color{230, 230, 230, 255};
-    case world::TileType::Coin: return SDL_Color{245, 220, 120, 255};
-    case world::TileType::Wood: return SDL_Color{120, 82, 50, 255};
-    case world::TileType::Leaves: return SDL_Color{60, 180, 90, 220};
-    case world::TileType::WoodPlank: return SDL_Color{180, 130, 80, 255};
-    case world::TileType::StoneBrick: return SDL_Color{150, 125, 125, 255};
-    case world::TileType::TreeTrunk: return SDL_Color{130, 90, 55, 200};
-    case world::TileType::TreeLeaves: return SDL_Color{70, 190, 100, 180};
-    case world::TileType::Air:
-    default: return SDL_Color{0, 0, 0, 0};
-    }
+SDL_Color SdlTileColor(world::TileType type) {
+    const Rgba color = TileColor(type);
+    return SDL_Color{color.r, color.g, color.b, color.a};
 }
 
 const char* TileName(world::TileType type) {
@@ -232,7 +223,11 @@ public:
             throw std::runtime_error(std::string("Failed to create window: ") + SDL_GetError());
         }
 
-        renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+        if (config_.vsync) {
+            rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+        }
+        renderer_ = SDL_CreateRenderer(window_, -1, rendererFlags);
         if (!renderer_) {
             SDL_DestroyWindow(window_);
             window_ = nullptr;
@@ -246,20 +241,21 @@ public:
 
     void render(const world::World& world,
                 const entities::Player& player,
-                const std::vector<entities::Zombie>& zombies,
-                const HudState& hud) override {
+                const HudState& hud,
+                core::FrameArena& frame) override {
+        frame_ = &frame;
         const SDL_Color sky = SkyColor(hud);
         SDL_SetRenderDrawColor(renderer_, sky.r, sky.g, sky.b, sky.a);
         SDL_RenderClear(renderer_);
 
         if (hud.minimapFullscreen) {
             drawMinimap(world, player, hud);
-            SDL_RenderPresent(renderer_);
+            present();
             return;
         }
         if (hud.menuHideWorld) {
             drawMenuOverlay(hud);
-            SDL_RenderPresent(renderer_);
+            present();
             return;
         }
 
@@ -268,8 +264,8 @@ public:
 
         const int maxStartX = std::max(world.width() - tilesWide, 0);
         const int maxStartY = std::max(world.height() - tilesTall, 0);
-        float focusX = hud.useCamera ? hud.cameraX : player.position().x;
-        float focusY = hud.useCamera ? hud.cameraY : player.position().y;
+        float focusX = hud.useCamera ? hud.cameraX : hud.playerX;
+        float focusY = hud.useCamera ? hud.cameraY : hud.playerY;
         float viewX = focusX - static_cast<float>(tilesWide) / 2.0F;
         float viewY = focusY - static_cast<float>(tilesTall) / 2.0F;
         viewX = std::clamp(viewX, 0.0F, static_cast<float>(maxStartX));
@@ -281,67 +277,70 @@ public:
         const int pixelOffsetX = static_cast<int>(std::floor(-subTileOffsetX * kTilePixels));
         const int pixelOffsetY = static_cast<int>(std::floor(-subTileOffsetY * kTilePixels));
 
-        for (int y = 0; y < tilesTall && (startY + y) < world.height(); ++y) {
-            for (int x = 0; x < tilesWide && (startX + x) < world.width(); ++x) {
-                const int worldX = startX + x;
-                const int worldY = startY + y;
-                const auto& tile = world.tile(worldX, worldY);
-                if (!tile.active() || tile.type() == world::TileType::Air) {
-                    continue;
-                }
+        {
+            TERRARIA_TRACE_ZONE("render.tiles");
+            for (int y = 0; y < tilesTall && (startY + y) < world.height(); ++y) {
+                for (int x = 0; x < tilesWide && (startX + x) < world.width(); ++x) {
+                    const int worldX = startX + x;
+                    const int worldY = startY + y;
+                    const auto& tile = world.tile(worldX, worldY);
+                    if (!tile.active() || tile.type() == world::TileType::Air) {
+                        continue;
+                    }
 
-                SDL_Rect rect{ pixelOffsetX + x * kTilePixels, pixelOffsetY + y * kTilePixels, kTilePixels, kTilePixels };
-                if (const TileTexture* textureInfo = tileTexture(tile.type())) {
-                    SDL_Rect src = atlasRectFor(world, tile.type(), startX + x, startY + y);
-                    SDL_RenderCopy(renderer_, textureInfo->texture, &src, &rect);
-                } else {
-                    const SDL_Color color = TileColor(tile.type());
-                    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
-                    SDL_RenderFillRect(renderer_, &rect);
-                }
+                    SDL_Rect rect{ pixelOffsetX + x * kTilePixels, pixelOffsetY + y * kTilePixels, kTilePixels, kTilePixels };
+                    if (const TileTexture* textureInfo = tileTexture(tile.type())) {
+                        SDL_Rect src = atlasRectFor(world, tile.type(), startX + x, startY + y);
+                        SDL_RenderCopy(renderer_, textureInfo->texture, &src, &rect);
+                    } else {
+                        const SDL_Color color = SdlTileColor(tile.type());
+                        SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+                        SDL_RenderFillRect(renderer_, &rect);
+                    }
 
-                if (tile.isSolid()) {
-                    const auto neighborIsSolid = [&](int nx, int ny) {
-                        if (nx < 0 || nx >= world.width() || ny < 0 || ny >= world.height()) {
-                            return true;
-                        }
-                        const auto& neighbor = world.tile(nx, ny);
-                        return neighbor.active() && neighbor.isSolid();
-                    };
-
-                    constexpr int kFogRadius = 6;
-                    bool foundAir = false;
-                    int distanceToAir = kFogRadius + 1;
-                    for (int r = 1; r <= kFogRadius && !foundAir; ++r) {
-                        for (int dx = -r; dx <= r && !foundAir; ++dx) {
-                            const int dy = r - std::abs(dx);
-                            if (dy == 0) {
-                                if (!neighborIsSolid(worldX + dx, worldY)) {
-                                    foundAir = true;
-                                    distanceToAir = r;
-                                }
-                            } else {
-                                if (!neighborIsSolid(worldX + dx, worldY + dy)
-                                    || !neighborIsSolid(worldX + dx, worldY - dy)) {
-                                    foundAir = true;
-                                    distanceToAir = r;
+                    if (tile.isSolid()) {
+                        const auto neighborIsSolid = [&](int nx, int ny) {
+                            if (nx < 0 || nx >= world.width() || ny < 0 || ny >= world.height()) {
+                                return true;
+                            }
+                            const auto& neighbor = world.tile(nx, ny);
+                            return neighbor.active() && neighbor.isSolid();
+                        };
+
+                        constexpr int kFogRadius = 6;
+                        bool foundAir = false;
+                        int distanceToAir = kFogRadius + 1;
+                        for (int r = 1; r <= kFogRadius && !foundAir; ++r) {
+                            for (int dx = -r; dx <= r && !foundAir; ++dx) {
+                                const int dy = r - std::abs(dx);
+                                if (dy == 0) {
+                                    if (!neighborIsSolid(worldX + dx, worldY)) {
+                                        foundAir = true;
+                                        distanceToAir = r;
+                                    }
+                                } else {
+                                    if (!neighborIsSolid(worldX + dx, worldY + dy)
+                                        || !neighborIsSolid(worldX + dx, worldY - dy)) {
+                                        foundAir = true;
+                                        distanceToAir = r;
+                                    }
                                 }
                             }
                         }
-                    }
 
-                    Uint8 alpha = 0;
-                    if (!foundAir) {
-                        alpha = 255;
-                    } else {
-                        constexpr int kMinAlpha = 60;
-                        constexpr int kMaxAlpha = 220;
-                        const int spread = std::max(1, kFogRadius - 1);
-                        alpha = static_cast<Uint8>(kMinAlpha + (distanceToAir - 1) * (kMaxAlpha - kMinAlpha) / spread);
-                    }
-                    if (alpha > 0) {
-                        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, alpha);
-                        SDL_RenderFillRect(renderer_, &rect);
+                        Uint8 alpha = 0;
+                        if (!foundAir) {
+                            alpha = 255;
+                        } else {
+                            constexpr int kMinAlpha = 60;
+                            constexpr int kMaxAlpha = 220;
+                            const int spread = std::max(1, kFogRadius - 1);
+                            alpha = static_cast<Uint8>(kMinAlpha + (distanceToAir - 1) * (kMaxAlpha - kMinAlpha) / spread);
+                        }
+                        if (alpha > 0) {
+                            SDL_SetRenderDrawColor(renderer_, 0, 0, 0, alpha);
+                            SDL_RenderFillRect(renderer_, &rect);
+                        }
                     }
                 }
             }
@@ -400,17 +399,21 @@ public:
             SDL_RenderDrawRect(renderer_, &bg);
         }
 
-        drawProjectiles(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawEnemyProjectiles(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawZombies(zombies, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawFlyingEnemies(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawWorms(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawDragon(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawSwordSwing(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawDamageNumbers(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
-        drawPlayer(player, startX, startY, pixelOffsetX, pixelOffsetY);
+        {
+            TERRARIA_TRACE_ZONE("render.entities");
+            drawProjectiles(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawEnemyProjectiles(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawZombies(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawFlyingEnemies(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawWorms(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawDragon(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawSwordSwing(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawDamageNumbers(hud, startX, startY, tilesWide, tilesTall, pixelOffsetX, pixelOffsetY);
+            drawPlayer({hud.playerX, hud.playerY}, startX, startY, pixelOffsetX, pixelOffsetY);
+        }
         drawMinimap(world, player, hud);
         if (!hud.menuHideGameUi) {
+            TERRARIA_TRACE_ZONE("render.ui");
             drawStatusWidgets(hud);
             drawChatOverlay(hud);
             drawConsoleOverlay(hud);
@@ -419,6 +422,11 @@ public:
         }
         drawMenuOverlay(hud);
 
+        present();
+    }
+
+    void present() {
+        TERRARIA_TRACE_ZONE("render.present");
         SDL_RenderPresent(renderer_);
     }
 
@@ -444,6 +452,7 @@ private:
     core::AppConfig config_;
     SDL_Window* window_{nullptr};
     SDL_Renderer* renderer_{nullptr};
+    std::pmr::memory_resource* frame_{std::pmr::get_default_resource()}; // the current frame's arena
     std::unordered_map<world::TileType, TileTexture> tileTextures_{};
     std::unordered_map<world::TileType, std::unordered_map<std::string, std::vector<SDL_Rect>>> tileMaskRects_{};
     std::unordered_map<std::string, SDL_Texture*> itemTextures_{};
@@ -737,12 +746,12 @@ private:
         }
     }
 
-    void drawPlayer(const entities::Player& player, int startX, int startY, int pixelOffsetX, int pixelOffsetY) {
+    void drawPlayer(const entities::Vec2& position, int startX, int startY, int pixelOffsetX, int pixelOffsetY) {
         const float playerPixelWidth = entities::kPlayerHalfWidth * 2.0F * static_cast<float>(kTilePixels);
         const float playerPixelHeight = entities::kPlayerHeight * static_cast<float>(kTilePixels);
-        const float playerPixelX = pixelOffsetX + (player.position().x - static_cast<float>(startX)) * static_cast<float>(kTilePixels);
+        const float playerPixelX = pixelOffsetX + (position.x - static_cast<float>(startX)) * static_cast<float>(kTilePixels);
         const float playerPixelBottom =
-            pixelOffsetY + (player.position().y - static_cast<float>(startY)) * static_cast<float>(kTilePixels);
+            pixelOffsetY + (position.y - static_cast<float>(startY)) * static_cast<float>(kTilePixels);
         const int rectWidth = std::max(2, static_cast<int>(std::round(playerPixelWidth)));
         const int rectHeight = std::max(2, static_cast<int>(std::round(playerPixelHeight)));
         const int rectX = static_cast<int>(std::round(playerPixelX - playerPixelWidth / 2.0F));
@@ -980,18 +989,18 @@ private:
         }
     }
 
-    void drawZombies(const std::vector<entities::Zombie>& zombies,
+    void drawZombies(const HudState& hud,
                      int startX,
                      int startY,
                      int tilesWide,
                      int tilesTall,
                      int pixelOffsetX,
                      int pixelOffsetY) {
-        for (const auto& zombie : zombies) {
-            const float zombieLeft = zombie.position.x - entities::kZombieHalfWidth;
-            const float zombieRight = zombie.position.x + entities::kZombieHalfWidth;
-            const float zombieTop = zombie.position.y - entities::kZombieHeight;
-            const float zombieBottom = zombie.position.y;
+        for (const auto& zombie : hud.zombies) {
+            const float zombieLeft = zombie.x - entities::kZombieHalfWidth;
+            const float zombieRight = zombie.x + entities::kZombieHalfWidth;
+            const float zombieTop = zombie.y - entities::kZombieHeight;
+            const float zombieBottom = zombie.y;
             if (zombieRight < static_cast<float>(startX) || zombieLeft > static_cast<float>(startX + tilesWide)) {
                 continue;
             }
@@ -1001,8 +1010,8 @@ private:
 
             const float pixelWidth = entities::kZombieHalfWidth * 2.0F * static_cast<float>(kTilePixels);
             const float pixelHeight = entities::kZombieHeight * static_cast<float>(kTilePixels);
-            const float pixelX = pixelOffsetX + (zombie.position.x - static_cast<float>(startX)) * static_cast<float>(kTilePixels);
-            const float pixelBottom = pixelOffsetY + (zombie.position.y - static_cast<float>(startY)) * static_cast<float>(kTilePixels);
+            const float pixelX = pixelOffsetX + (zombie.x - static_cast<float>(startX)) * static_cast<float>(kTilePixels);
+            const float pixelBottom = pixelOffsetY + (zombie.y - static_cast<float>(startY)) * static_cast<float>(kTilePixels);
             const int rectWidth = std::max(2, static_cast<int>(std::round(pixelWidth)));
             const int rectHeight = std::max(2, static_cast<int>(std::round(pixelHeight)));
             const int rectX = static_cast<int>(std::round(pixelX - pixelWidth / 2.0F));
@@ -1063,6 +1072,14 @@ private:
         SDL_SetRenderDrawColor(renderer_, 70, 70, 70, 255);
         SDL_RenderDrawRect(renderer_, &defensePanel);
         drawNumber("DEF " + std::to_string(std::max(0, hud.playerDefense)), defensePanel.x + 6, defensePanel.y + 4, 2, SDL_Color{200, 220, 255, 255});
+        if (hud.saving) {
+            SDL_Rect savePanel{defensePanel.x + defensePanel.w + 8, defensePanel.y, 90, 20};
+            SDL_SetRenderDrawColor(renderer_, 10, 10, 10, 200);
+            SDL_RenderFillRect(renderer_, &savePanel);
+            SDL_SetRenderDrawColor(renderer_, 70, 70, 70, 255);
+            SDL_RenderDrawRect(renderer_, &savePanel);
+            drawNumber("SAVING", savePanel.x + 8, savePanel.y + 4, 2, SDL_Color{240, 210, 120, 255});
+        }
 
         const int cycleWidth = 150;
         const int cycleHeight = 12;
@@ -1098,7 +1115,7 @@ private:
         drawNumber("Y " + std::to_string(hud.playerTileY), coordPanel.x + coordPanel.w / 2, coordPanel.y + 4, 2, coordColor);
 
         const int perfWidth = 170;
-        const int perfHeight = 74;
+        const int perfHeight = 128;
         const int perfX = coordX;
         const int perfY = coordY + coordHeight + 8;
         SDL_Rect perfPanel{perfX, perfY, perfWidth, perfHeight};
@@ -1115,9 +1132,83 @@ private:
         drawNumber("FT " + std::to_string(frameMs) + "MS", perfPanel.x + 6, perfPanel.y + 22, 2, perfColor);
         drawNumber("UP " + std::to_string(updateMs) + "MS", perfPanel.x + 6, perfPanel.y + 40, 2, perfColor);
         drawNumber("RD " + std::to_string(renderMs) + "MS", perfPanel.x + 6, perfPanel.y + 58, 2, perfColor);
+        drawNumber("AL " + std::to_string(hud.perfHeapAllocations), perfPanel.x + 6, perfPanel.y + 76, 2, perfColor);
+        drawNumber("TK " + std::to_string(hud.simulationTick), perfPanel.x + 6, perfPanel.y + 94, 2, perfColor);
+        char hashText[12];
+        std::snprintf(hashText, sizeof(hashText), "%08llX", static_cast<unsigned long long>(hud.stateHash & 0xFFFFFFFFULL));
+        drawNumber(std::string{"H "} + hashText, perfPanel.x + 6, perfPanel.y + 112, 2, perfColor);
+        if (hud.perfExpanded) {
+            drawPerfDistribution(hud, perfX, perfY + perfHeight + 8, perfWidth);
+        }
+    }
+
+    // F3 panel: rolling percentiles per phase, the frame-time histogram with the frame budget marked,
+    // and live/peak megabytes per memory tag.
+    void drawPerfDistribution(const HudState& hud, int x, int y, int width) {
+        constexpr int kRowHeight = 10;
+        constexpr int kBarWidth = 2;
+        constexpr int kBarsHeight = 36;
+        const int barsY = y + 6 + 4 * kRowHeight + 4;
+        const int memoryY = barsY + kBarsHeight + 6 + kRowHeight;
+        const int memoryRows = static_cast<int>(hud.perfMemory.size()) + 1;
+        SDL_Rect panel{x, y, width, memoryY + memoryRows * kRowHeight - y};
+        SDL_SetRenderDrawColor(renderer_, 12, 12, 12, 200);
+        SDL_RenderFillRect(renderer_, &panel);
+        SDL_SetRenderDrawColor(renderer_, 70, 70, 70, 255);
+        SDL_RenderDrawRect(renderer_, &panel);
+
+        const SDL_Color textColor{200, 200, 200, 255};
+        const std::array<int, 4> columns{x + 30, x + 64, x + 98, x + 132};
+        const std::array<const char*, 4> headers{"P50", "P95", "P99", "MAX"};
+        for (std::size_t i = 0; i < headers.size(); ++i) {
+            drawNumber(headers[i], columns[i], y + 6, 1, textColor);
+        }
+        const auto drawRow = [&](const char* label, const core::TimingSummary& timing, int rowY) {
+            drawNumber(label, x + 6, rowY, 1, textColor);
+            const std::array<float, 4> values{timing.p50, timing.p95, timing.p99, timing.max};
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                char text[16];
+                std::snprintf(text, sizeof(text), "%.1f", static_cast<double>(values[i]));
+                drawNumber(text, columns[i], rowY, 1, textColor);
+            }
+        };
+        drawRow("FT", hud.perfFrameTiming, y + 6 + kRowHeight);
+        drawRow("UP", hud.perfUpdateTiming, y + 6 + 2 * kRowHeight);
+        drawRow("RD", hud.perfRenderTiming, y + 6 + 3 * kRowHeight);
+
+        const std::uint32_t tallest = *std::max_element(hud.perfFrameHistogram.begin(), hud.perfFrameHistogram.end());
+        const int barsX = x + (width - static_cast<int>(hud.perfFrameHistogram.size()) * kBarWidth) / 2;
+        if (config_.targetFps > 0) {
+            const std::size_t budget = core::RollingHistogram::bucketFor(1000.0F / static_cast<float>(config_.targetFps));
+            SDL_SetRenderDrawColor(renderer_, 220, 80, 80, 200);
+            const int budgetX = barsX + static_cast<int>(budget) * kBarWidth + kBarWidth;
+            SDL_RenderDrawLine(renderer_, budgetX, barsY, budgetX, barsY + kBarsHeight);
+        }
+        SDL_SetRenderDrawColor(renderer_, 120, 200, 140, 230);
+        for (std::size_t i = 0; i < hud.perfFrameHistogram.size() && tallest > 0; ++i) {
+            const int height = static_cast<int>((static_cast<std::uint64_t>(hud.perfFrameHistogram[i]) * kBarsHeight + tallest - 1) / tallest);
+            SDL_Rect bar{barsX + static_cast<int>(i) * kBarWidth, barsY + kBarsHeight - height, kBarWidth, height};
+            SDL_RenderFillRect(renderer_, &bar);
+        }
+        drawNumber("HITCH " + std::to_string(hud.perfHitches), x + 6, barsY + kBarsHeight + 6, 1, textColor);
+
+        drawNumber("MB", x + 6, memoryY, 1, textColor);
+        drawNumber("LIVE", columns[2], memoryY, 1, textColor);
+        drawNumber("PEAK", columns[3], memoryY, 1, textColor);
+        for (std::size_t i = 0; i < hud.perfMemory.size(); ++i) {
+            const int rowY = memoryY + static_cast<int>(i + 1) * kRowHeight;
+            drawNumber(core::MemoryTagName(static_cast<core::MemoryTag>(i)), x + 6, rowY, 1, textColor);
+            const std::array<std::size_t, 2> values{hud.perfMemory[i].live, hud.perfMemory[i].peak};
+            for (std::size_t column = 0; column < values.size(); ++column) {
+                char text[16];
+                std::snprintf(text, sizeof(text), "%.1f", static_cast<double>(values[column]) / (1024.0 * 1024.0));
+                drawNumber(text, columns[2 + column], rowY, 1, textColor);
+            }
+        }
     }
 
     void drawMinimap(const world::World& world, const entities::Player& player, const HudState& hud) {
+        TERRARIA_TRACE_ZONE("render.minimap");
         if (hud.menuHideGameUi && !hud.minimapFullscreen) {
             return;
         }
@@ -1147,16 +1238,17 @@ private:
         const float worldPerPixel = std::max(basePerPixelX, basePerPixelY) / zoom;
         const float spanX = worldPerPixel * static_cast<float>(mapWidth);
         const float spanY = worldPerPixel * static_cast<float>(mapHeight);
-        const float centerX = hud.minimapFullscreen ? hud.minimapCenterX : player.position().x;
-        const float centerY = hud.minimapFullscreen ? hud.minimapCenterY : player.position().y;
+        const float centerX = hud.minimapFullscreen ? hud.minimapCenterX : hud.playerX;
+        const float centerY = hud.minimapFullscreen ? hud.minimapCenterY : hud.playerY;
         float startX = centerX - spanX * 0.5F;
         float startY = centerY - spanY * 0.5F;
         startX = std::clamp(startX, 0.0F, std::max(0.0F, static_cast<float>(world.width()) - spanX));
         startY = std::clamp(startY, 0.0F, std::max(0.0F, static_cast<float>(world.height()) - spanY));
+        const auto* explored = player.exploredMap(hud.minimapWorldId);
         const int maxSamples = hud.minimapFullscreen ? 60000 : 14000;
         const int sampleStep = std::max(1, static_cast<int>(std::ceil(std::sqrt(
             static_cast<float>(mapWidth * mapHeight) / static_cast<float>(maxSamples)))));
-        for (int my = 0; my < mapHeight; my += sampleStep) {
+        for (int my = 0; explored && my < mapHeight; my += sampleStep) {
             const float sampleY = startY + static_cast<float>(my) * worldPerPixel;
             if (sampleY < 0.0F || sampleY >= static_cast<float>(world.height())) {
                 continue;
@@ -1168,7 +1260,10 @@ private:
                     continue;
                 }
                 const int tileX = static_cast<int>(std::floor(sampleX));
-                const Uint8 visibility = player.exploredValue(hud.minimapWorldId, tileX, tileY);
+                if (tileX >= explored->width || tileY >= explored->height) {
+                    continue;
+                }
+                const Uint8 visibility = explored->value(tileX, tileY);
                 if (visibility == 0) {
                     continue;
                 }
@@ -1177,7 +1272,7 @@ private:
                 if (!tile.active() || tile.type() == world::TileType::Air) {
                     color = SDL_Color{16, 16, 20, 180};
                 } else {
-                    color = TileColor(tile.type());
+                    color = SdlTileColor(tile.type());
                 }
                 const int baseAlpha = color.a ? color.a : 220;
                 const int finalAlpha = std::clamp(static_cast<int>(baseAlpha) * visibility / 255, 0, 255);
@@ -1187,8 +1282,8 @@ private:
             }
         }
 
-        int playerMapX = x + static_cast<int>((player.position().x - startX) / spanX * mapWidth);
-        int playerMapY = y + static_cast<int>((player.position().y - startY) / spanY * mapHeight);
+        int playerMapX = x + static_cast<int>((hud.playerX - startX) / spanX * mapWidth);
+        int playerMapY = y + static_cast<int>((hud.playerY - startY) / spanY * mapHeight);
         playerMapX = std::clamp(playerMapX, x + 2, x + mapWidth - 3);
         playerMapY = std::clamp(playerMapY, y + 2, y + mapHeight - 3);
         SDL_SetRenderDrawColor(renderer_, 255, 220, 120, 255);
@@ -1254,7 +1349,7 @@ private:
         const int maxLines = 6;
         const int panelWidth = std::min(520, config_.windowWidth - margin * 2);
         const float ttl = 4.0F;
-        std::vector<const ChatLineHud*> visibleLines;
+        std::pmr::vector<const ChatLineHud*> visibleLines{frame_};
         visibleLines.reserve(maxLines);
         for (auto it = hud.chatLines.rbegin(); it != hud.chatLines.rend() && static_cast<int>(visibleLines.size()) < maxLines; ++it) {
             if (!hud.consoleOpen && it->age >= ttl) {
@@ -1282,6 +1377,7 @@ private:
     }
 
     void drawMenuOverlay(const HudState& hud) {
+        TERRARIA_TRACE_ZONE("render.menu");
         if (!hud.menuOpen) {
             return;
         }
@@ -1548,7 +1644,7 @@ private:
                 SDL_RenderFillRect(renderer_, &swatch);
                 drawNumber("AC", panel.x + 8, panel.y + 8, 2, SDL_Color{20, 20, 20, 230});
             } else if (slotData.tileType != world::TileType::Air) {
-                const SDL_Color tileColor = TileColor(slotData.tileType);
+                const SDL_Color tileColor = SdlTileColor(slotData.tileType);
                 SDL_Rect swatch{panel.x + 6, panel.y + 6, 28, panel.h - (12 + labelHeight)};
                 if (itemTex) {
                     SDL_SetRenderDrawColor(renderer_, 10, 10, 12, 170);
@@ -1672,7 +1768,7 @@ private:
             } else if (entry.outputIsAccessory) {
                 outputColor = AccessoryColor(entry.accessoryId);
             } else {
-                outputColor = TileColor(entry.outputType);
+                outputColor = SdlTileColor(entry.outputType);
             }
             SDL_Rect outputRect{x + padding, y + padding, 16, rowHeight - padding * 2};
             SDL_Texture* outputTex = itemTextureForCraft(entry);
@@ -1730,7 +1826,7 @@ private:
                     SDL_RenderFillRect(renderer_, &ingRect);
                     drawTextureInRect(ingredientTex, ingRect);
                 } else {
-                    const SDL_Color ingredientColor = TileColor(entry.ingredientTypes[static_cast<std::size_t>(ing)]);
+                    const SDL_Color ingredientColor = SdlTileColor(entry.ingredientTypes[static_cast<std::size_t>(ing)]);
                     SDL_SetRenderDrawColor(renderer_, ingredientColor.r, ingredientColor.g, ingredientColor.b, ingredientColor.a);
                     SDL_RenderFillRect(renderer_, &ingRect);
                 }
@@ -1800,8 +1896,9 @@ private:
         pattern[2] = neighborCode(tileX, tileY + 1);
         pattern[3] = neighborCode(tileX - 1, tileY);
 
-        std::vector<std::string> candidatePatterns;
-        candidatePatterns.push_back(pattern);
+        // Called for every visible tile, so the (at most three) candidates live in a fixed array.
+        std::array<std::string, 3> candidatePatterns{pattern};
+        std::size_t candidateCount = 1;
 
         const bool containsDirt = pattern.find('d') != std::string::npos;
         const bool treatDirtAsSame = (type == world::TileType::Dirt);
@@ -1812,7 +1909,7 @@ private:
                     c = 'x';
                 }
             }
-            candidatePatterns.push_back(asSame);
+            candidatePatterns[candidateCount++] = asSame;
         }
         if (containsDirt) {
             auto asAir = pattern;
@@ -1821,14 +1918,15 @@ private:
                     c = '0';
                 }
             }
-            candidatePatterns.push_back(asAir);
+            candidatePatterns[candidateCount++] = asAir;
         }
 
         const auto typeMaskIt = tileMaskRects_.find(type);
         if (typeMaskIt != tileMaskRects_.end()) {
             const auto& patternMap = typeMaskIt->second;
             const std::size_t base = static_cast<std::size_t>((tileX * 73856093) ^ (tileY * 19349663));
-            for (const auto& key : candidatePatterns) {
+            for (std::size_t i = 0; i < candidateCount; ++i) {
+                const std::string& key = candidatePatterns[i];
                 const auto rectIt = patternMap.find(key);
                 if (rectIt == patternMap.end() || rectIt->second.empty()) {
                     continue;
@@ -1851,10 +1949,28 @@ private:
         SDL_FreeSurface(surface);
         if (!texture) {
             SDL_Log("Failed to create texture for %s: %s", path.string().c_str(), SDL_GetError());
+            return nullptr;
         }
+        core::TrackAllocation(core::MemoryTag::Textures, textureBytes(texture));
         return texture;
     }
 
+    void destroyTexture(SDL_Texture* texture) {
+        core::TrackDeallocation(core::MemoryTag::Textures, textureBytes(texture));
+        SDL_DestroyTexture(texture);
+    }
+
+    // Estimated from size and pixel format; the driver may pad or keep a second copy.
+    static std::size_t textureBytes(SDL_Texture* texture) {
+        Uint32 format = 0;
+        int width = 0;
+        int height = 0;
+        if (SDL_QueryTexture(texture, &format, nullptr, &width, &height) != 0) {
+            return 0;
+        }
+        return static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * SDL_BYTESPERPIXEL(format);
+    }
+
     void loadTileTextures() {
         destroyTileTextures();
         const std::filesystem::path basePath = std::filesystem::path("graphics") / "tiles";
@@ -1893,7 +2009,7 @@ private:
     void destroyTileTextures() {
         for (auto& pair : tileTextures_) {
             if (pair.second.texture) {
-                SDL_DestroyTexture(pair.second.texture);
+                destroyTexture(pair.second.texture);
             }
         }
         tileTextures_.clear();
@@ -1931,7 +2047,7 @@ private:
     void destroyItemTextures() {
         for (auto& entry : itemTextures_) {
             if (entry.second) {
-                SDL_DestroyTexture(entry.second);
+                destroyTexture(entry.second);
             }
         }
         itemTextures_.clear();
@@ -0,0 +1,71 @@
+#include "terraria/tools/Commands.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace terraria::tools {
+
+namespace {
+
+void printUsage() {
+    std::printf("usage: terra_clone [command] [args]\n");
+    std::printf("  bench-save [width height]   world save/load throughput at 1, 2, 4 and 8 threads\n");
+    std::printf("  bench-enemies [steps]       enemy update cost per enemy at 10, 100, 1000 and 10000 enemies\n");
+    std::printf("  diff-worlds <a> <b>         list chunks whose hashes differ between two world files\n");
+    std::printf("  verify-world <dir> <id>     check a saved world against its chunk hashes\n");
+    std::printf("  export-map <dir> <id> <bmp> render a saved world (or --region) to a BMP image\n");
+    std::printf("  record <file> [seed]        play a deterministic session, recording input to file\n");
+    std::printf("  replay <file> [--realtime]  re-run a recorded session and print its state hashes\n");
+    std::printf("  simulate [--ticks n]        run a headless deterministic session on a new world\n");
+}
+
+int dispatch(const std::string& command, const std::vector<std::string>& args) {
+    if (command == "bench-save") {
+        return RunSaveBenchmark(args);
+    }
+    if (command == "bench-enemies") {
+        return RunEnemyBenchmark(args);
+    }
+    if (command == "diff-worlds") {
+        return RunWorldDiff(args);
+    }
+    if (command == "verify-world") {
+        return RunWorldVerify(args);
+    }
+    if (command == "export-map") {
+        return RunMapExport(args);
+    }
+    if (command == "record") {
+        return RunRecordSession(args);
+    }
+    if (command == "replay") {
+        return RunReplaySession(args);
+    }
+    if (command == "simulate") {
+        return RunSimulateSession(args);
+    }
+    printUsage();
+    return 2;
+}
+
+} // namespace
+
+int RunCommand(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 2;
+    }
+    const std::string command = argv[1];
+    const std::vector<std::string> args(argv + 2, argv + argc);
+    // Commands parse numbers with std::stoi and friends; a malformed one is a usage error, not a crash.
+    try {
+        return dispatch(command, args);
+    } catch (const std::invalid_argument&) {
+    } catch (const std::out_of_range&) {
+    }
+    std::printf("%s: invalid numeric argument\n", command.c_str());
+    printUsage();
+    return 2;
+}
+
+} // namespace terraria::tools
@@ -0,0 +1,127 @@
+#include "terraria/tools/Commands.h"
+
+#include "terraria/core/Application.h"
+#include "terraria/game/BodyStore.h"
+#include "terraria/game/DamageNumberSystem.h"
+#include "terraria/game/EnemyManager.h"
+#include "terraria/game/PhysicsSystem.h"
+#include "terraria/world/World.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace terraria::tools {
+
+namespace {
+
+constexpr int kColumnsPerEnemy = 4;
+constexpr int kMinWorldWidth = world::World::kChunkSize;
+constexpr int kWorldHeight = 128;
+constexpr int kGroundRow = 96;
+constexpr int kWarmupSteps = 30;
+constexpr float kStep = 1.0F / 60.0F;
+
+struct EnemyBenchmarkRun {
+    std::size_t enemies{0};
+    double nanosecondsPerStep{0.0};
+};
+
+EnemyBenchmarkRun runEnemyBenchmark(int worldWidth, int count, int steps) {
+    world::World world(worldWidth, kWorldHeight);
+    for (int y = kGroundRow; y < kWorldHeight; ++y) {
+        for (int x = 0; x < worldWidth; ++x) {
+            world.setTile(x, y, world::TileType::Dirt, true);
+        }
+    }
+    game::PhysicsSystem physics(world);
+    entities::Player player;
+    player.setPosition({static_cast<float>(worldWidth) / 2.0F, static_cast<float>(kGroundRow) - 0.001F});
+    game::DamageNumberSystem damageNumbers;
+
+    // The view covers the whole world so nothing despawns off screen, and the caps hold the count steady.
+    core::AppConfig config{};
+    config.windowWidth = worldWidth * 16;
+    config.windowHeight = kWorldHeight * 16;
+    config.maxZombies = count;
+    config.maxFlyers = count;
+    config.maxWorms = count;
+    game::EnemyManager enemies(config, world, player, physics, damageNumbers);
+    enemies.seed(7);
+    enemies.zombies().reserve(static_cast<std::size_t>(count));
+    enemies.flyers().reserve(static_cast<std::size_t>(count));
+    enemies.worms().reserve(static_cast<std::size_t>(count));
+
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> column(2.0F, static_cast<float>(worldWidth) - 2.0F);
+    std::uniform_real_distribution<float> sky(8.0F, static_cast<float>(kGroundRow) - 8.0F);
+    std::uniform_real_distribution<float> underground(static_cast<float>(kGroundRow) + 2.0F,
+                                                      static_cast<float>(kWorldHeight) - 2.0F);
+    for (int i = 0; i < count; ++i) {
+        if (i % 4 < 2) {
+            enemies.spawnZombieAt({column(rng), static_cast<float>(kGroundRow) - 0.001F});
+        } else if (i % 4 == 2) {
+            enemies.spawnFlyerAt({column(rng), sky(rng)});
+        } else {
+            enemies.spawnWormAt({column(rng), underground(rng)});
+        }
+    }
+
+    game::BodyStore bodies;
+    const auto step = [&] {
+        bodies.clear();
+        enemies.update(kStep, true, player.position(), bodies);
+        physics.step(bodies, kStep);
+        enemies.resolve(true, bodies);
+        enemies.storePreviousPositions();
+    };
+    for (int i = 0; i < kWarmupSteps; ++i) {
+        step();
+    }
+    const std::size_t alive = enemies.zombies().size() + enemies.flyers().size() + enemies.worms().size();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i) {
+        step();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return {alive, seconds * 1.0e9 / static_cast<double>(steps)};
+}
+
+} // namespace
+
+// The world widens with the count so enemy density, and with it the neighbour work, stays the same. Each
+// size is also run empty; that per-step cost (flow field, clearing and sorting the broadphase) is
+// reported as fixed and left out of the per-enemy figure.
+int RunEnemyBenchmark(const std::vector<std::string>& args) {
+    int steps = 600;
+    if (!args.empty()) {
+        steps = std::stoi(args[0]);
+    }
+    if (steps <= 0) {
+        std::printf("bench-enemies: invalid step count\n");
+        return 2;
+    }
+
+    std::printf("flat world %d tiles tall at night, one enemy per %d columns, %d steps,"
+                " half zombies, a quarter flyers, a quarter worms\n",
+                kWorldHeight,
+                kColumnsPerEnemy,
+                steps);
+    for (const int count : {10, 100, 1000, 10000}) {
+        const int worldWidth = std::max(kMinWorldWidth, count * kColumnsPerEnemy);
+        const EnemyBenchmarkRun empty = runEnemyBenchmark(worldWidth, 0, steps);
+        const EnemyBenchmarkRun full = runEnemyBenchmark(worldWidth, count, steps);
+        const double perEnemy = full.enemies > 0
+            ? std::max(0.0, full.nanosecondsPerStep - empty.nanosecondsPerStep) / static_cast<double>(full.enemies)
+            : 0.0;
+        std::printf("enemies %6zu  width %6d  fixed %8.1f us per step  %8.1f ns per enemy per step\n",
+                    full.enemies,
+                    worldWidth,
+                    empty.nanosecondsPerStep / 1000.0,
+                    perEnemy);
+    }
+    return 0;
+}
+
+} // namespace terraria::tools
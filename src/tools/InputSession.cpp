@@ -0,0 +1,121 @@
+#include "terraria/tools/Commands.h"
+
+#include "terraria/core/Application.h"
+#include "terraria/core/MemoryTags.h"
+#include "terraria/input/InputRecording.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace terraria::tools {
+
+int RunRecordSession(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        std::printf("record: usage: record <file> [seed]\n");
+        return 2;
+    }
+    // Like simulate, a recording plays a throwaway world generated from its seed: starting from the
+    // on-disk menu would make the replay depend on whatever saves exist by then.
+    core::AppConfig config{};
+    config.deterministic = true;
+    config.autoStartSession = true;
+    config.persistSaves = false;
+    config.recordInputPath = args[0];
+    if (args.size() >= 2) {
+        config.simulationSeed = std::stoull(args[1]);
+    }
+    core::Application app{config};
+    app.run();
+    return 0;
+}
+
+int RunReplaySession(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        std::printf("replay: usage: replay <file> [--realtime] [--headless]\n");
+        return 2;
+    }
+    input::InputRecordingHeader header{};
+    if (!input::ReadInputRecordingHeader(args[0], header)) {
+        std::printf("replay: %s is not an input recording\n", args[0].c_str());
+        return 1;
+    }
+    bool realtime = false;
+    bool headless = false;
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        realtime = realtime || args[i] == "--realtime";
+        headless = headless || args[i] == "--headless";
+    }
+
+    core::AppConfig config{};
+    config.deterministic = true;
+    config.simulationHz = static_cast<int>(header.simulationHz);
+    config.simulationSeed = header.simulationSeed;
+    config.worldWidth = header.worldWidth;
+    config.worldHeight = header.worldHeight;
+    config.windowWidth = header.windowWidth;
+    config.windowHeight = header.windowHeight;
+    config.replayInputPath = args[0];
+    config.headless = headless;
+    config.autoStartSession = true;
+    config.persistSaves = false;
+    if (!realtime) {
+        config.targetFps = 0;
+        config.vsync = false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    core::Application app{config};
+    app.run();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("replay finished in %.2f s\n", seconds);
+    return 0;
+}
+
+int RunSimulateSession(const std::vector<std::string>& args) {
+    core::AppConfig config{};
+    config.deterministic = true;
+    config.headless = true;
+    config.autoStartSession = true;
+    config.persistSaves = false;
+    config.maxTicks = 3600;
+    config.targetFps = 0;
+    config.vsync = false;
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const bool hasValue = i + 1 < args.size();
+        if (args[i] == "--ticks" && hasValue) {
+            config.maxTicks = std::stoull(args[++i]);
+        } else if (args[i] == "--seed" && hasValue) {
+            config.simulationSeed = std::stoull(args[++i]);
+        } else if (args[i] == "--size" && i + 2 < args.size()) {
+            config.worldWidth = std::stoi(args[++i]);
+            config.worldHeight = std::stoi(args[++i]);
+        } else if (args[i] == "--realtime") {
+            config.targetFps = config.simulationHz;
+        } else if (args[i] == "--trace" && hasValue) {
+            config.traceFrames = std::stoi(args[++i]);
+        } else if (args[i] == "--hitch-ms" && hasValue) {
+            config.hitchThresholdMs = std::stof(args[++i]);
+        } else {
+            std::printf("simulate: usage: simulate [--ticks n] [--seed s] [--size w h] [--realtime] [--trace frames]"
+                        " [--hitch-ms ms]\n");
+            return 2;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    core::Application app{config};
+    app.run();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("simulated %llu ticks in %.2f s (%.1f ticks/s)\n",
+                static_cast<unsigned long long>(config.maxTicks),
+                seconds,
+                seconds > 0.0 ? static_cast<double>(config.maxTicks) / seconds : 0.0);
+    for (std::size_t tag = 0; tag < core::kMemoryTagCount; ++tag) {
+        std::printf("peak %-14s %8.2f MB\n",
+                    core::MemoryTagName(static_cast<core::MemoryTag>(tag)),
+                    static_cast<double>(core::MemoryUsage(static_cast<core::MemoryTag>(tag)).peak) / (1024.0 * 1024.0));
+    }
+    return 0;
+}
+
+} // namespace terraria::tools
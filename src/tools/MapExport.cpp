@@ -0,0 +1,227 @@
+#include "terraria/tools/Commands.h"
+
+#include "terraria/core/Parallel.h"
+#include "terraria/entities/Player.h"
+#include "terraria/game/SaveManager.h"
+#include "terraria/rendering/Palette.h"
+#include "terraria/world/World.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace terraria::tools {
+
+namespace {
+
+constexpr int kBandRows = world::World::kChunkSize;
+constexpr rendering::Rgba kBackground{16, 16, 20, 255};
+
+struct ExportOptions {
+    std::string savesDir{};
+    std::string worldId{};
+    std::string outputPath{};
+    std::string characterId{};
+    int regionX{0};
+    int regionY{0};
+    int regionWidth{0};
+    int regionHeight{0};
+    int scale{1};
+};
+
+bool parseOptions(const std::vector<std::string>& args, ExportOptions& options) {
+    if (args.size() < 3) {
+        return false;
+    }
+    options.savesDir = args[0];
+    options.worldId = args[1];
+    options.outputPath = args[2];
+    for (std::size_t i = 3; i < args.size(); ++i) {
+        if (args[i] == "--region" && i + 4 < args.size()) {
+            options.regionX = std::stoi(args[i + 1]);
+            options.regionY = std::stoi(args[i + 2]);
+            options.regionWidth = std::stoi(args[i + 3]);
+            options.regionHeight = std::stoi(args[i + 4]);
+            i += 4;
+        } else if (args[i] == "--scale" && i + 1 < args.size()) {
+            options.scale = std::stoi(args[++i]);
+        } else if (args[i] == "--explored" && i + 1 < args.size()) {
+            options.characterId = args[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.scale >= 1;
+}
+
+// Packed cell -> BGR, blended over the map background.
+std::array<std::array<std::uint8_t, 3>, 256> buildCellColors() {
+    std::array<std::array<std::uint8_t, 3>, 256> colors{};
+    for (int cell = 0; cell < 256; ++cell) {
+        const auto packed = static_cast<std::uint8_t>(cell);
+        rendering::Rgba color = kBackground;
+        if ((packed & world::kTileActiveBit) != 0) {
+            const auto type = static_cast<world::TileType>(packed & world::kTileTypeMask);
+            const rendering::Rgba tile = rendering::TileColor(type);
+            const int alpha = tile.a;
+            const auto blend = [alpha](int over, int under) {
+                return static_cast<std::uint8_t>((over * alpha + under * (255 - alpha)) / 255);
+            };
+            color = rendering::Rgba{blend(tile.r, kBackground.r), blend(tile.g, kBackground.g), blend(tile.b, kBackground.b), 255};
+        }
+        colors[static_cast<std::size_t>(cell)] = {color.b, color.g, color.r};
+    }
+    return colors;
+}
+
+void putLe16(std::uint8_t* out, std::uint16_t value) {
+    out[0] = static_cast<std::uint8_t>(value);
+    out[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void putLe32(std::uint8_t* out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+// 24-bit BMP with a negative height so rows are written top-down as they are produced.
+bool writeBmpHeader(std::FILE* file, int width, int height, std::size_t rowBytes) {
+    const std::uint64_t imageBytes = static_cast<std::uint64_t>(rowBytes) * static_cast<std::uint64_t>(height);
+    if (imageBytes + 54 > 0xFFFFFFFFULL) {
+        return false;
+    }
+    std::array<std::uint8_t, 54> header{};
+    header[0] = 'B';
+    header[1] = 'M';
+    putLe32(&header[2], static_cast<std::uint32_t>(imageBytes + 54));
+    putLe32(&header[10], 54);
+    putLe32(&header[14], 40);
+    putLe32(&header[18], static_cast<std::uint32_t>(width));
+    putLe32(&header[22], static_cast<std::uint32_t>(-height));
+    putLe16(&header[26], 1);
+    putLe16(&header[28], 24);
+    putLe32(&header[34], static_cast<std::uint32_t>(imageBytes));
+    putLe32(&header[38], 2835);
+    putLe32(&header[42], 2835);
+    return std::fwrite(header.data(), 1, header.size(), file) == header.size();
+}
+
+} // namespace
+
+int RunMapExport(const std::vector<std::string>& args) {
+    ExportOptions options{};
+    if (!parseOptions(args, options)) {
+        std::printf("usage: terra_clone export-map <saves-dir> <world-id> <out.bmp> "
+                    "[--region x y w h] [--scale n] [--explored character-id]\n");
+        return 2;
+    }
+
+    game::SaveManager saves(options.savesDir);
+    world::World world(1, 1);
+    std::string name;
+    std::uint32_t seed = 0;
+    world::WorldGenerator::WorldGenConfig genConfig{};
+    float spawnX = 0.0F;
+    float spawnY = 0.0F;
+    float timeOfDay = 0.0F;
+    bool isNight = false;
+    if (!saves.loadWorld(options.worldId, world, name, seed, genConfig, spawnX, spawnY, timeOfDay, isNight)) {
+        std::printf("export-map: cannot load world %s\n", options.worldId.c_str());
+        return 2;
+    }
+
+    entities::Player player{};
+    const entities::Player::MapExploration* explored = nullptr;
+    if (!options.characterId.empty()) {
+        const std::string mapKey = options.worldId + "#" + std::to_string(seed);
+        saves.loadExploredMap(options.characterId, mapKey, player);
+        explored = player.exploredMap(mapKey);
+        if (!explored || explored->width != world.width() || explored->height != world.height()) {
+            std::printf("export-map: %s has no explored map for %s\n", options.characterId.c_str(), options.worldId.c_str());
+            return 2;
+        }
+    }
+
+    if (options.regionWidth <= 0 || options.regionHeight <= 0) {
+        options.regionX = 0;
+        options.regionY = 0;
+        options.regionWidth = world.width();
+        options.regionHeight = world.height();
+    }
+    const int x0 = std::clamp(options.regionX, 0, world.width());
+    const int y0 = std::clamp(options.regionY, 0, world.height());
+    const int x1 = std::clamp(options.regionX + options.regionWidth, x0, world.width());
+    const int y1 = std::clamp(options.regionY + options.regionHeight, y0, world.height());
+    const int scale = options.scale;
+    const int width = (x1 - x0 + scale - 1) / scale;
+    const int height = (y1 - y0 + scale - 1) / scale;
+    if (width <= 0 || height <= 0) {
+        std::printf("export-map: empty region\n");
+        return 2;
+    }
+
+    std::FILE* file = std::fopen(options.outputPath.c_str(), "wb");
+    if (!file) {
+        std::printf("export-map: cannot open %s\n", options.outputPath.c_str());
+        return 2;
+    }
+    const std::size_t rowBytes = (static_cast<std::size_t>(width) * 3 + 3) & ~static_cast<std::size_t>(3);
+    if (!writeBmpHeader(file, width, height, rowBytes)) {
+        std::printf("export-map: image too large for BMP, use --region or --scale\n");
+        std::fclose(file);
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto colors = buildCellColors();
+    const std::uint8_t* cells = world.cells();
+    const auto chunksX = static_cast<std::size_t>(world.chunksX());
+    const auto chunkSize = static_cast<std::size_t>(world::World::kChunkSize);
+    std::vector<std::uint8_t> band(rowBytes * kBandRows, 0);
+    bool ok = true;
+    for (int bandStart = 0; bandStart < height && ok; bandStart += kBandRows) {
+        const int rows = std::min(kBandRows, height - bandStart);
+        core::ParallelFor(static_cast<std::size_t>(rows), core::DefaultThreadCount(), [&](std::size_t row) {
+            std::uint8_t* out = band.data() + row * rowBytes;
+            const auto y = static_cast<std::size_t>(y0 + (bandStart + static_cast<int>(row)) * scale);
+            const std::uint8_t* chunkRow = cells + (y / chunkSize) * chunksX * world::World::kChunkArea + (y % chunkSize) * chunkSize;
+            for (int px = 0; px < width; ++px) {
+                const auto x = static_cast<std::size_t>(x0 + px * scale);
+                const std::uint8_t cell = chunkRow[(x / chunkSize) * world::World::kChunkArea + x % chunkSize];
+                const auto& color = colors[cell];
+                if (explored) {
+                    const int visibility = explored->value(static_cast<int>(x), static_cast<int>(y));
+                    out[0] = static_cast<std::uint8_t>(color[0] * visibility / 255);
+                    out[1] = static_cast<std::uint8_t>(color[1] * visibility / 255);
+                    out[2] = static_cast<std::uint8_t>(color[2] * visibility / 255);
+                } else {
+                    std::memcpy(out, color.data(), 3);
+                }
+                out += 3;
+            }
+        });
+        const std::size_t bytes = rowBytes * static_cast<std::size_t>(rows);
+        ok = std::fwrite(band.data(), 1, bytes, file) == bytes;
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::printf("export-map: write to %s failed\n", options.outputPath.c_str());
+        return 1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double megapixels = static_cast<double>(width) * static_cast<double>(height) / 1.0e6;
+    std::printf("%s: %dx%d px, %.1f MP in %.0f ms (%.0f MP/s)\n",
+                options.outputPath.c_str(),
+                width,
+                height,
+                megapixels,
+                seconds * 1000.0,
+                seconds > 0.0 ? megapixels / seconds : 0.0);
+    return 0;
+}
+
+} // namespace terraria::tools
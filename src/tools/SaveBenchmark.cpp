@@ -0,0 +1,84 @@
+#include "terraria/tools/Commands.h"
+
+#include "terraria/game/SaveManager.h"
+#include "terraria/world/WorldGenerator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+namespace terraria::tools {
+
+namespace {
+
+constexpr int kBenchmarkRuns = 3;
+
+double megabytesPerSecond(std::size_t bytes, double seconds) {
+    return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+} // namespace
+
+int RunSaveBenchmark(const std::vector<std::string>& args) {
+    int width = 4096;
+    int height = 768;
+    if (args.size() >= 2) {
+        width = std::stoi(args[0]);
+        height = std::stoi(args[1]);
+    }
+    if (width <= 0 || height <= 0) {
+        std::printf("bench-save: invalid world size\n");
+        return 2;
+    }
+
+    world::World world(width, height);
+    world::WorldGenerator generator;
+    const std::uint32_t seed = 1337;
+    generator.generate(world, seed);
+    const auto snapshot = game::SaveManager::snapshotWorld("bench", "bench", world, seed, {}, 0.0F, 0.0F, 0.0F, false);
+    const std::size_t bytes = snapshot.tiles.size();
+
+    const auto basePath = std::filesystem::temp_directory_path() / "terra_clone_bench";
+    std::printf("world %dx%d, %.1f MB of cells, block encoding\n", width, height,
+                static_cast<double>(bytes) / (1024.0 * 1024.0));
+    for (const int threads : {1, 2, 4, 8}) {
+        game::SaveManager saves(basePath);
+        saves.setWorldEncoding(game::SaveManager::WorldEncoding::Blocks);
+        saves.setWorkerThreads(threads);
+        double saveSeconds = 0.0;
+        double loadSeconds = 0.0;
+        for (int run = 0; run < kBenchmarkRuns; ++run) {
+            const auto saveStart = std::chrono::steady_clock::now();
+            if (!saves.saveWorld(snapshot)) {
+                std::printf("bench-save: save failed\n");
+                return 1;
+            }
+            const auto saveEnd = std::chrono::steady_clock::now();
+            world::World loaded(1, 1);
+            std::string name;
+            std::uint32_t loadedSeed = 0;
+            world::WorldGenerator::WorldGenConfig genConfig{};
+            float spawnX = 0.0F;
+            float spawnY = 0.0F;
+            float timeOfDay = 0.0F;
+            bool isNight = false;
+            if (!saves.loadWorld("bench", loaded, name, loadedSeed, genConfig, spawnX, spawnY, timeOfDay, isNight)) {
+                std::printf("bench-save: load failed\n");
+                return 1;
+            }
+            const auto loadEnd = std::chrono::steady_clock::now();
+            saveSeconds += std::chrono::duration<double>(saveEnd - saveStart).count();
+            loadSeconds += std::chrono::duration<double>(loadEnd - saveEnd).count();
+        }
+        std::printf("threads %d  save %8.1f MB/s  load %8.1f MB/s\n",
+                    threads,
+                    megabytesPerSecond(bytes * kBenchmarkRuns, saveSeconds),
+                    megabytesPerSecond(bytes * kBenchmarkRuns, loadSeconds));
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(basePath, ec);
+    return 0;
+}
+
+} // namespace terraria::tools
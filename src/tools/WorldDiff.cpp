@@ -0,0 +1,89 @@
+#include "terraria/tools/Commands.h"
+
+#include "terraria/game/SaveManager.h"
+#include "terraria/world/World.h"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace terraria::tools {
+
+namespace {
+
+void printChunk(const char* label, std::size_t chunk, int chunksX) {
+    const int cx = static_cast<int>(chunk % static_cast<std::size_t>(chunksX));
+    const int cy = static_cast<int>(chunk / static_cast<std::size_t>(chunksX));
+    std::printf("  %s chunk %zu (%d, %d) tiles %d,%d\n",
+                label,
+                chunk,
+                cx,
+                cy,
+                cx * world::World::kChunkSize,
+                cy * world::World::kChunkSize);
+}
+
+} // namespace
+
+int RunWorldDiff(const std::vector<std::string>& args) {
+    if (args.size() != 2) {
+        std::printf("usage: terra_clone diff-worlds <a.world> <b.world>\n");
+        return 2;
+    }
+    int widthA = 0;
+    int heightA = 0;
+    int widthB = 0;
+    int heightB = 0;
+    std::vector<std::uint64_t> hashesA;
+    std::vector<std::uint64_t> hashesB;
+    if (!game::SaveManager::readChunkHashes(args[0], widthA, heightA, hashesA)) {
+        std::printf("diff-worlds: cannot read chunk table of %s\n", args[0].c_str());
+        return 2;
+    }
+    if (!game::SaveManager::readChunkHashes(args[1], widthB, heightB, hashesB)) {
+        std::printf("diff-worlds: cannot read chunk table of %s\n", args[1].c_str());
+        return 2;
+    }
+    if (widthA != widthB || heightA != heightB) {
+        std::printf("worlds differ in size: %dx%d vs %dx%d\n", widthA, heightA, widthB, heightB);
+        return 1;
+    }
+    const int chunksX = (widthA + world::World::kChunkSize - 1) / world::World::kChunkSize;
+    std::size_t changed = 0;
+    for (std::size_t chunk = 0; chunk < hashesA.size(); ++chunk) {
+        if (hashesA[chunk] != hashesB[chunk]) {
+            printChunk("changed", chunk, chunksX);
+            ++changed;
+        }
+    }
+    std::printf("%zu of %zu chunks differ\n", changed, hashesA.size());
+    return changed == 0 ? 0 : 1;
+}
+
+int RunWorldVerify(const std::vector<std::string>& args) {
+    if (args.size() != 2) {
+        std::printf("usage: terra_clone verify-world <saves-dir> <world-id>\n");
+        return 2;
+    }
+    game::SaveManager saves(args[0]);
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint64_t> hashes;
+    const auto path = std::filesystem::path(args[0]) / "worlds" / (args[1] + ".world");
+    if (!game::SaveManager::readChunkHashes(path, width, height, hashes)) {
+        std::printf("verify-world: %s is missing, unreadable or has no chunk table\n", path.string().c_str());
+        return 2;
+    }
+    std::vector<std::size_t> mismatched;
+    if (saves.verifyWorld(args[1], mismatched)) {
+        std::printf("%s: %zu chunks ok\n", args[1].c_str(), hashes.size());
+        return 0;
+    }
+    const int chunksX = (width + world::World::kChunkSize - 1) / world::World::kChunkSize;
+    for (const std::size_t chunk : mismatched) {
+        printChunk("corrupt", chunk, chunksX);
+    }
+    std::printf("%s: %zu of %zu chunks fail verification\n", args[1].c_str(), mismatched.size(), hashes.size());
+    return 1;
+}
+
+} // namespace terraria::tools
@@ -0,0 +1,102 @@
+#include "terraria/world/MappedRegion.h"
+
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TERRARIA_HAS_MMAP 1
+#endif
+
+namespace terraria::world {
+
+MappedRegion::~MappedRegion() {
+    reset();
+}
+
+MappedRegion::MappedRegion(MappedRegion&& other) noexcept
+    : base_{std::exchange(other.base_, nullptr)},
+      baseLength_{std::exchange(other.baseLength_, 0)},
+      data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      fallback_{std::move(other.fallback_)} {
+    other.fallback_.clear();
+}
+
+MappedRegion& MappedRegion::operator=(MappedRegion&& other) noexcept {
+    if (this != &other) {
+        reset();
+        base_ = std::exchange(other.base_, nullptr);
+        baseLength_ = std::exchange(other.baseLength_, 0);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        fallback_ = std::move(other.fallback_);
+        other.fallback_.clear();
+    }
+    return *this;
+}
+
+bool MappedRegion::open(const std::filesystem::path& path, std::uint64_t offset, std::size_t length) {
+    reset();
+    if (length == 0) {
+        return false;
+    }
+#ifdef TERRARIA_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < offset + length) {
+        ::close(fd);
+        return false;
+    }
+    const auto pageSize = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    const std::uint64_t alignedOffset = offset - (offset % pageSize);
+    const auto lead = static_cast<std::size_t>(offset - alignedOffset);
+    void* base = ::mmap(nullptr, lead + length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    base_ = base;
+    baseLength_ = lead + length;
+    data_ = static_cast<std::uint8_t*>(base) + lead;
+    size_ = length;
+    return true;
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    in.seekg(static_cast<std::streamoff>(offset));
+    fallback_.resize(length);
+    in.read(reinterpret_cast<char*>(fallback_.data()), static_cast<std::streamsize>(length));
+    if (!in) {
+        fallback_.clear();
+        return false;
+    }
+    data_ = fallback_.data();
+    size_ = length;
+    return true;
+#endif
+}
+
+void MappedRegion::reset() {
+#ifdef TERRARIA_HAS_MMAP
+    if (base_) {
+        ::munmap(base_, baseLength_);
+    }
+#endif
+    base_ = nullptr;
+    baseLength_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+    fallback_.clear();
+    fallback_.shrink_to_fit();
+}
+
+} // namespace terraria::world
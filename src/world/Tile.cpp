@@ -1,5 +1,6 @@
 #include "terraria/world/Tile.h"
 
+#include <array>
 #include <memory>
 
 namespace terraria::world {
@@ -21,4 +22,16 @@ std::unique_ptr<Tile> MakeTile(TileType type, bool active) {
     }
 }
 
+const Tile& SharedTile(std::uint8_t packed) {
+    static const std::array<std::unique_ptr<Tile>, 256> kTiles = []() {
+        std::array<std::unique_ptr<Tile>, 256> tiles{};
+        for (std::size_t i = 0; i < tiles.size(); ++i) {
+            const auto value = static_cast<std::uint8_t>(i);
+            tiles[i] = MakeTile(static_cast<TileType>(value & kTileTypeMask), (value & kTileActiveBit) != 0);
+        }
+        return tiles;
+    }();
+    return *kTiles[packed];
+}
+
 } // namespace terraria::world
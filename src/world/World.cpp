@@ -1,33 +1,86 @@
 #include "terraria/world/World.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <stdexcept>
+#include <utility>
 
 namespace terraria::world {
 
+namespace {
+
+int chunkSpan(int tiles) {
+    return (std::max(tiles, 0) + World::kChunkSize - 1) / World::kChunkSize;
+}
+
+std::uint64_t cellHash(std::size_t offset, std::uint8_t cell) {
+    std::uint64_t z = (static_cast<std::uint64_t>(offset) << 8 | cell) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+std::uint64_t ChunkHash(const std::uint8_t* cells) {
+    std::uint64_t hash = 0;
+    for (std::size_t i = 0; i < World::kChunkArea; ++i) {
+        hash += cellHash(i, cells[i]);
+    }
+    return hash;
+}
+
 World::World(int width, int height)
     : width_{width},
-      height_{height} {
-    const std::size_t total = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
-    tiles_.reserve(total);
-    for (std::size_t i = 0; i < total; ++i) {
-        tiles_.push_back(MakeTile(TileType::Air, false));
+      height_{height},
+      chunksX_{chunkSpan(width)},
+      chunksY_{chunkSpan(height)},
+      cells_(cellCountFor(width, height), PackTile(TileType::Air, false)) {
+    chunkHashes_.assign(chunkCount(), chunkCount() > 0 ? ChunkHash(cells_.data()) : 0);
+}
+
+World::World(int width, int height, MappedRegion cells, std::vector<std::uint64_t> chunkHashes)
+    : width_{width},
+      height_{height},
+      chunksX_{chunkSpan(width)},
+      chunksY_{chunkSpan(height)},
+      mapping_{std::move(cells)},
+      chunkHashes_{std::move(chunkHashes)} {
+    if (mapping_.size() != cellCountFor(width, height)) {
+        throw std::invalid_argument("World mapping does not match dimensions");
+    }
+    if (chunkHashes_.size() != chunkCount()) {
+        chunkHashes_.resize(chunkCount());
+        for (std::size_t chunk = 0; chunk < chunkCount(); ++chunk) {
+            rehashChunk(chunk);
+        }
     }
 }
 
-Tile& World::tile(int x, int y) {
-    const std::size_t idx = index(x, y);
-    return *tiles_[idx];
+std::size_t World::cellCountFor(int width, int height) {
+    return static_cast<std::size_t>(chunkSpan(width)) * static_cast<std::size_t>(chunkSpan(height)) * kChunkArea;
 }
 
 const Tile& World::tile(int x, int y) const {
-    const std::size_t idx = index(x, y);
-    return *tiles_[idx];
+    return SharedTile(cellData()[index(x, y)]);
+}
+
+std::uint8_t World::cell(int x, int y) const {
+    return cellData()[index(x, y)];
 }
 
 void World::setTile(int x, int y, TileType type, bool active) {
-    const std::size_t idx = index(x, y);
-    tiles_[idx] = MakeTile(type, active);
+    const std::uint8_t cell = PackTile(type, active);
+    const std::size_t at = index(x, y);
+    const std::uint8_t previous = cellData()[at];
+    if (previous != cell) {
+        const std::size_t offset = at % kChunkArea;
+        chunkHashes_[at / kChunkArea] += cellHash(offset, cell) - cellHash(offset, previous);
+        cellData()[at] = cell;
+    }
+    if (editListener_) {
+        editListener_(x, y, cell);
+    }
 }
 
 void World::setTileType(int x, int y, TileType type) {
@@ -35,11 +88,55 @@ void World::setTileType(int x, int y, TileType type) {
     setTile(x, y, type, wasActive);
 }
 
+void World::setChunk(std::size_t chunk, const std::uint8_t* cells) {
+    if (chunk >= chunkCount()) {
+        throw std::out_of_range("World::setChunk chunk out of range");
+    }
+    std::copy_n(cells, kChunkArea, cellData() + chunk * kChunkArea);
+    rehashChunk(chunk);
+}
+
+std::uint8_t* World::chunkCells(std::size_t chunk) {
+    if (chunk >= chunkCount()) {
+        throw std::out_of_range("World::chunkCells chunk out of range");
+    }
+    return cellData() + chunk * kChunkArea;
+}
+
+const std::uint8_t* World::chunkCells(std::size_t chunk) const {
+    if (chunk >= chunkCount()) {
+        throw std::out_of_range("World::chunkCells chunk out of range");
+    }
+    return cellData() + chunk * kChunkArea;
+}
+
+void World::rehashChunk(std::size_t chunk) {
+    chunkHashes_[chunk] = ChunkHash(chunkCells(chunk));
+}
+
+void World::setChunkHashes(std::vector<std::uint64_t> hashes) {
+    if (hashes.size() == chunkCount()) {
+        chunkHashes_ = std::move(hashes);
+    }
+}
+
 std::size_t World::index(int x, int y) const {
     if (x < 0 || x >= width_ || y < 0 || y >= height_) {
         throw std::out_of_range("World::tile coordinates out of range");
     }
-    return static_cast<std::size_t>(y * width_ + x);
+    const auto ux = static_cast<std::size_t>(x);
+    const auto uy = static_cast<std::size_t>(y);
+    const std::size_t size = static_cast<std::size_t>(kChunkSize);
+    const std::size_t chunk = (uy / size) * static_cast<std::size_t>(chunksX_) + ux / size;
+    return chunk * kChunkArea + (uy % size) * size + ux % size;
+}
+
+std::uint8_t* World::cellData() {
+    return mapping_.empty() ? cells_.data() : mapping_.data();
+}
+
+const std::uint8_t* World::cellData() const {
+    return mapping_.empty() ? cells_.data() : mapping_.data();
 }
 
 } // namespace terraria::world
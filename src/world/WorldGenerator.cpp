@@ -1,5 +1,7 @@
 #include "terraria/world/WorldGenerator.h"
 
+#include "terraria/core/Trace.h"
+
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -292,6 +294,7 @@ void WorldGenerator::generate(World& world, std::uint32_t seed) {
 }
 
 void WorldGenerator::generate(World& world, std::uint32_t seed, const WorldGenConfig& config) {
+    TERRARIA_TRACE_ZONE("worldgen");
     const int width = world.width();
     const int height = world.height();
     if (width <= 0 || height <= 0) {
@@ -302,15 +305,19 @@ void WorldGenerator::generate(World& world, std::uint32_t seed, const WorldGenCo
     const float soilScale = std::clamp(config.soilDepthScale, 0.4F, 2.0F);
     std::vector<int> surfaceY = buildSurfaceProfile(width, height, seed, terrainAmp);
     const int verticalInset = height / 8;
-    for (int x = 0; x < width; ++x) {
-        surfaceY[static_cast<std::size_t>(x)] = std::max(0, surfaceY[static_cast<std::size_t>(x)] - verticalInset);
-        paintColumn(world, x, surfaceY[static_cast<std::size_t>(x)], seed, soilScale);
+    {
+        TERRARIA_TRACE_ZONE("worldgen.terrain");
+        for (int x = 0; x < width; ++x) {
+            surfaceY[static_cast<std::size_t>(x)] = std::max(0, surfaceY[static_cast<std::size_t>(x)] - verticalInset);
+            paintColumn(world, x, surfaceY[static_cast<std::size_t>(x)], seed, soilScale);
+        }
     }
 
     carveCaves(world, seed, config);
     placeOres(world, seed, config);
     carveDragonDen(world, dragonDenInfo(world, seed));
 
+    TERRARIA_TRACE_ZONE("worldgen.trees");
     std::mt19937 rng{static_cast<std::uint32_t>(width * 977 + height * 131 + seed)};
     scatterSurfaceTrees(world, surfaceY, rng, config.treeDensity);
 }
@@ -339,6 +346,7 @@ WorldGenerator::DragonDenInfo WorldGenerator::dragonDenInfo(const World& world,
 }
 
 void WorldGenerator::carveCaves(World& world, std::uint32_t seed, const WorldGenConfig& config) {
+    TERRARIA_TRACE_ZONE("worldgen.caves");
     if (world.width() < 16 || world.height() < 16) {
         return;
     }
@@ -385,6 +393,7 @@ void WorldGenerator::carveCaves(World& world, std::uint32_t seed, const WorldGen
 }
 
 void WorldGenerator::carveDragonDen(World& world, const DragonDenInfo& info) {
+    TERRARIA_TRACE_ZONE("worldgen.dragonDen");
     if (info.radiusX <= 0 || info.radiusY <= 0) {
         return;
     }
@@ -438,6 +447,7 @@ void WorldGenerator::carveDragonDen(World& world, const DragonDenInfo& info) {
 }
 
 void WorldGenerator::placeOres(World& world, std::uint32_t seed, const WorldGenConfig& config) {
+    TERRARIA_TRACE_ZONE("worldgen.ores");
     std::mt19937 rng{static_cast<std::uint32_t>(4242 + seed)};
     const float oreScale = std::clamp(config.oreDensity, 0.3F, 2.5F);
     const std::array<OreConfig, 3> configs{{